@@ -0,0 +1,166 @@
+/*******************************************************************************
+@file     adc.c
+@author   agent
+@date     18.10.2026
+@brief    Continuous ADC acquisition engine for STM32F0xx.
+*******************************************************************************/
+
+#ifdef USE_ADC
+
+#include "adc.h"
+
+/*******************************************************************************
+ Driver state
+*******************************************************************************/
+
+#define   ADC_NONE  2U
+
+static uint16_t adc_buffer[2 * ADC_BLOCK];
+
+static struct
+{
+	volatile unsigned ready;     // completed block not taken yet, ADC_NONE if none
+	volatile unsigned busy;      // block held by the consumer, ADC_NONE if none
+	volatile uint32_t blocks;
+	volatile uint32_t overruns;
+
+}	adc = { ADC_NONE, ADC_NONE, 0, 0 };
+
+static_SEM(adc_sem, 0, semBinary);
+
+/******************************************************************************/
+
+void adc_init( uint32_t channels, unsigned rate )
+{
+	uint32_t period = CPU_FREQUENCY / rate;
+	uint32_t psc    = (period - 1) / 0x10000;
+
+	RCC->AHBENR  |= RCC_AHBENR_DMA1EN;
+	RCC->APB1ENR |= RCC_APB1ENR_TIM3EN;
+	RCC->APB2ENR |= RCC_APB2ENR_ADC1EN;
+
+	/* calibrate (ADEN = 0, DMAEN = 0, also after adc_stop) and enable the converter,
+	   clock: PCLK / 4; ADRDY of the previous enable is cleared */
+	ADC1->CR    = 0;
+	ADC1->CFGR1 = 0;
+	ADC1->CFGR2 = ADC_CFGR2_CKMODE_1;
+	ADC1->CR    = ADC_CR_ADCAL;
+	while (ADC1->CR & ADC_CR_ADCAL);
+	ADC1->ISR   = ADC_ISR_ADRDY;
+	ADC1->CR    = ADC_CR_ADEN;
+	while ((ADC1->ISR & ADC_ISR_ADRDY) == 0);
+
+	/* circular DMA, 16-bit samples, half and full transfer interrupts */
+	DMA1_Channel1->CCR   = 0;
+	DMA1_Channel1->CPAR  = (uint32_t) &ADC1->DR;
+	DMA1_Channel1->CMAR  = (uint32_t)  adc_buffer;
+	DMA1_Channel1->CNDTR = 2 * ADC_BLOCK;
+	DMA1_Channel1->CCR   = DMA_CCR_MINC | DMA_CCR_PSIZE_0 | DMA_CCR_MSIZE_0 | DMA_CCR_CIRC | DMA_CCR_HTIE | DMA_CCR_TCIE | DMA_CCR_EN;
+
+	/* scan on the rising edge of TIM3_TRGO (EXTSEL = 3) */
+	ADC1->CHSELR = channels;
+	ADC1->SMPR   = 0;
+	ADC1->CFGR1  = ADC_CFGR1_DMAEN | ADC_CFGR1_DMACFG | ADC_CFGR1_EXTEN_0 | ADC_CFGR1_EXTSEL_0 | ADC_CFGR1_EXTSEL_1;
+	ADC1->CR     = ADC_CR_ADEN | ADC_CR_ADSTART;
+
+	NVIC_EnableIRQ(DMA1_Channel1_IRQn);
+
+	/* TIM3: update event as TRGO */
+	TIM3->CR1 = 0;
+	TIM3->PSC = psc;
+	TIM3->ARR = period / (psc + 1) - 1;
+	TIM3->CR2 = TIM_CR2_MMS_1;
+	TIM3->EGR = TIM_EGR_UG;
+	TIM3->CR1 = TIM_CR1_CEN;
+}
+
+/******************************************************************************/
+
+void adc_stop( void )
+{
+	TIM3->CR1 = 0;
+	ADC1->CR |= ADC_CR_ADSTP;
+	while (ADC1->CR & ADC_CR_ADSTP);
+	ADC1->CR |= ADC_CR_ADDIS;
+	while (ADC1->CR & ADC_CR_ADEN);
+	NVIC_DisableIRQ(DMA1_Channel1_IRQn);
+	DMA1_Channel1->CCR = 0;
+	DMA1->IFCR = DMA_IFCR_CGIF1;
+
+	sys_lock();
+	adc.ready = ADC_NONE;
+	sys_unlock();
+}
+
+/******************************************************************************/
+
+uint16_t *adc_wait( cnt_t delay )
+{
+	unsigned blk;
+
+	adc.busy = ADC_NONE;
+
+	for (;;)
+	{
+		if (sem_waitFor(adc_sem, delay) != E_SUCCESS)
+			return NULL;
+
+		sys_lock();
+		blk = adc.ready;
+		adc.ready = ADC_NONE;
+		adc.busy = blk;
+		sys_unlock();
+
+		if (blk != ADC_NONE)
+			return adc_buffer + blk * ADC_BLOCK;
+	}
+}
+
+/******************************************************************************/
+
+uint32_t adc_blocks( void )
+{
+	return adc.blocks;
+}
+
+/******************************************************************************/
+
+uint32_t adc_overruns( void )
+{
+	return adc.overruns;
+}
+
+/*******************************************************************************
+ Interrupt handler
+*******************************************************************************/
+
+void DMA1_Channel1_IRQHandler( void )
+{
+	uint32_t isr = DMA1->ISR;
+	unsigned cnt = ((isr & DMA_ISR_HTIF1) != 0) + ((isr & DMA_ISR_TCIF1) != 0);
+	unsigned blk;
+
+	if (cnt == 0)
+		return;
+
+	DMA1->IFCR = DMA_IFCR_CGIF1;
+
+	/* the last completed block is the one before the block written now;
+	   with both flags pending the interrupt came late: the block completed
+	   before it has already been overwritten and is lost */
+	blk = DMA1_Channel1->CNDTR > ADC_BLOCK ? 1 : 0;
+	if (cnt == 2)
+		adc.overruns++;
+
+	/* the DMA is now writing the other block: it must not be the one in use */
+	if (adc.ready != ADC_NONE || adc.busy == (blk ^ 1))
+		adc.overruns++;
+
+	adc.ready = blk;
+	adc.blocks += cnt;
+	sem_giveISR(adc_sem);
+}
+
+/******************************************************************************/
+
+#endif//USE_ADC
@@ -0,0 +1,64 @@
+/*******************************************************************************
+@file     adc.h
+@author   agent
+@date     18.10.2026
+@brief    Continuous ADC acquisition engine for STM32F0xx.
+          Enabled with USE_ADC in DEFS.
+          TIM3 triggers a scan of the selected channels, DMA1 channel 1
+          stores the results in a circular buffer of two blocks.
+*******************************************************************************/
+
+#pragma once
+
+#include <os.h>
+#include <stm32f0xx.h>
+
+/*******************************************************************************
+ Configuration
+*******************************************************************************/
+
+#ifndef   ADC_BLOCK
+#define   ADC_BLOCK         64    // <- number of samples in one block (half of the buffer)
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*******************************************************************************
+ Start the acquisition
+ channels: bit mask of the converted channels (ADC_CHSELR), scanned in ascending order
+ rate:     number of scans per second
+ ADC_BLOCK should be a multiple of the number of channels
+*******************************************************************************/
+
+void      adc_init( uint32_t channels, unsigned rate );
+
+/*******************************************************************************
+ Stop the acquisition; adc_init starts it again
+*******************************************************************************/
+
+void      adc_stop( void );
+
+/*******************************************************************************
+ Wait for the next completed block; a single consumer task is assumed
+ the block is handed over without copying and stays valid until the next call
+ of adc_wait; if the consumer is still holding the block when the DMA wraps
+ around to it, or misses a block, an overrun is counted
+ return: pointer to ADC_BLOCK samples, NULL on timeout
+*******************************************************************************/
+
+uint16_t *adc_wait( cnt_t delay );
+
+/*******************************************************************************
+ Statistics
+*******************************************************************************/
+
+uint32_t  adc_blocks( void );   // number of completed blocks
+uint32_t  adc_overruns( void ); // number of detected overruns
+
+#ifdef __cplusplus
+}
+#endif
+
+/******************************************************************************/
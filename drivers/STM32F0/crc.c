@@ -0,0 +1,188 @@
+/*******************************************************************************
+@file     crc.c
+@author   agent
+@date     18.10.2026
+@brief    Hardware CRC-32 (IEEE 802.3) calculation unit driver for STM32F0xx.
+*******************************************************************************/
+
+#ifdef USE_CRC
+
+#include "crc.h"
+
+/*******************************************************************************
+ DMA channel
+*******************************************************************************/
+
+#if       CRC_DMA_CHANNEL < 1 || CRC_DMA_CHANNEL > 5
+#error    Invalid CRC_DMA_CHANNEL value!
+#endif
+#if       CRC_DMA_CHANNEL == 1 && defined(USE_ADC)
+#error    DMA1 channel 1 is used by the ADC driver!
+#endif
+#if      (CRC_DMA_CHANNEL == 2 || CRC_DMA_CHANNEL == 3) && defined(USE_USART)
+#error    DMA1 channels 2 and 3 are used by the USART driver!
+#endif
+#if      (CRC_DMA_CHANNEL == 4 || CRC_DMA_CHANNEL == 5) && defined(USE_SPI)
+#error    DMA1 channels 4 and 5 are used by the SPI driver!
+#endif
+
+#define   CRC_CAT(a, b)  a ## b
+#define   CRC_XCAT(a, b) CRC_CAT(a, b)
+
+#define   CRC_DMA       CRC_XCAT(DMA1_Channel,  CRC_DMA_CHANNEL)
+#define   CRC_DMA_TC    CRC_XCAT(DMA_ISR_TCIF,  CRC_DMA_CHANNEL)
+#define   CRC_DMA_GIF   CRC_XCAT(DMA_IFCR_CGIF, CRC_DMA_CHANNEL)
+
+#if       CRC_DMA_CHANNEL == 1
+#define   CRC_DMA_IRQn        DMA1_Channel1_IRQn
+#define   CRC_DMA_IRQHandler  DMA1_Channel1_IRQHandler
+#elif     CRC_DMA_CHANNEL <= 3
+#define   CRC_DMA_IRQn        DMA1_Channel2_3_IRQn
+#define   CRC_DMA_IRQHandler  DMA1_Channel2_3_IRQHandler
+#else
+#define   CRC_DMA_IRQn        DMA1_Channel4_5_IRQn
+#define   CRC_DMA_IRQHandler  DMA1_Channel4_5_IRQHandler
+#endif
+
+/*******************************************************************************
+ Configuration of the unit
+ words are reversed by word: little-endian words give the reflected byte order
+ bytes are reversed by byte
+*******************************************************************************/
+
+#define   CRC_WORD      (CRC_CR_REV_IN_0 | CRC_CR_REV_IN_1 | CRC_CR_REV_OUT)
+#define   CRC_BYTE      (CRC_CR_REV_IN_0 | CRC_CR_REV_OUT)
+
+static_SEM(crc_lock, 1, semBinary);
+static_SEM(crc_done, 0, semBinary); // DMA transfer completed
+
+/* -------------------------------------------------------------------------- */
+
+static
+void crc_bytes( const uint8_t *data, size_t size )
+{
+	CRC->CR = CRC_BYTE;
+	while (size--) *(volatile uint8_t *) &CRC->DR = *data++;
+	CRC->CR = CRC_WORD;
+}
+
+/* -------------------------------------------------------------------------- */
+
+static
+void crc_dma( const uint32_t *data, size_t count )
+{
+	while (count > 0)
+	{
+		size_t len = count < 0xFFFF ? count : 0xFFFF;
+
+		CRC_DMA->CCR   = 0;
+		CRC_DMA->CPAR  = (uint32_t) &CRC->DR;
+		CRC_DMA->CMAR  = (uint32_t)  data;
+		CRC_DMA->CNDTR = len;
+		DMA1->IFCR     = CRC_DMA_GIF;
+		CRC_DMA->CCR   = DMA_CCR_MEM2MEM | DMA_CCR_MSIZE_1 | DMA_CCR_PSIZE_1 | DMA_CCR_MINC | DMA_CCR_DIR | DMA_CCR_TCIE | DMA_CCR_EN;
+
+		/* other tasks run while the unit is fed, the interrupt wakes the caller */
+		sem_wait(crc_done);
+
+		data  += len;
+		count -= len;
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+static
+void crc_words( const uint32_t *data, size_t count )
+{
+	if (count * 4 >= CRC_DMA_MIN)
+	{
+		crc_dma(data, count);
+		return;
+	}
+
+	while (count >= 4)
+	{
+		CRC->DR = data[0];
+		CRC->DR = data[1];
+		CRC->DR = data[2];
+		CRC->DR = data[3];
+		data  += 4;
+		count -= 4;
+	}
+
+	while (count--) CRC->DR = *data++;
+}
+
+/******************************************************************************/
+
+void crc_begin( void )
+{
+	sem_wait(crc_lock);
+
+	RCC->AHBENR |= RCC_AHBENR_CRCEN | RCC_AHBENR_DMA1EN;
+	NVIC_EnableIRQ(CRC_DMA_IRQn);
+
+	CRC->INIT = 0xFFFFFFFF;
+	CRC->CR   = CRC_WORD | CRC_CR_RESET;
+}
+
+/******************************************************************************/
+
+void crc_update( const void *data, size_t size )
+{
+	const uint8_t *ptr = data;
+	size_t         len = (0U - (uintptr_t) ptr) & 3U;
+
+	if (len > size) len = size;
+
+	/* leading bytes up to the word boundary */
+	crc_bytes(ptr, len);
+	ptr  += len;
+	size -= len;
+
+	/* aligned words */
+	crc_words((const uint32_t *) ptr, size / 4);
+	ptr  += size & ~(size_t) 3;
+
+	/* trailing bytes */
+	crc_bytes(ptr, size & 3U);
+}
+
+/******************************************************************************/
+
+uint32_t crc_end( void )
+{
+	uint32_t crc = ~CRC->DR;
+
+	sem_give(crc_lock);
+
+	return crc;
+}
+
+/******************************************************************************/
+
+uint32_t crc_calc( const void *data, size_t size )
+{
+	crc_begin();
+	crc_update(data, size);
+	return crc_end();
+}
+
+/*******************************************************************************
+ Interrupt handler
+*******************************************************************************/
+
+void CRC_DMA_IRQHandler( void )
+{
+	if (DMA1->ISR & CRC_DMA_TC)
+	{
+		CRC_DMA->CCR = 0;
+		DMA1->IFCR   = CRC_DMA_GIF;
+		sem_giveISR(crc_done);
+	}
+}
+
+/******************************************************************************/
+
+#endif//USE_CRC
@@ -0,0 +1,51 @@
+/*******************************************************************************
+@file     crc.h
+@author   agent
+@date     18.10.2026
+@brief    Hardware CRC-32 (IEEE 802.3) calculation unit driver for STM32F0xx.
+          Enabled with USE_CRC in DEFS.
+          Large buffers are fed to the unit by DMA (memory to memory mode),
+          the caller sleeps until the transfer complete interrupt.
+*******************************************************************************/
+
+#pragma once
+
+#include <os.h>
+#include <stm32f0xx.h>
+
+/*******************************************************************************
+ Configuration
+*******************************************************************************/
+
+#ifndef   CRC_DMA_CHANNEL
+#define   CRC_DMA_CHANNEL    1    // <- DMA1 channel (and its interrupt) used for large buffers
+#endif
+#ifndef   CRC_DMA_MIN
+#define   CRC_DMA_MIN     1024    // <- smallest buffer (in bytes) fed by DMA
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*******************************************************************************
+ Calculate CRC-32 of the buffer (the same result as zlib crc32)
+ the unit is shared between tasks with an owner lock; not for interrupt handlers
+*******************************************************************************/
+
+uint32_t crc_calc( const void *data, size_t size );
+
+/*******************************************************************************
+ Calculate CRC-32 of data given in several parts
+ crc_begin takes the unit, crc_end returns the result and releases the unit
+*******************************************************************************/
+
+void     crc_begin( void );
+void     crc_update( const void *data, size_t size );
+uint32_t crc_end( void );
+
+#ifdef __cplusplus
+}
+#endif
+
+/******************************************************************************/
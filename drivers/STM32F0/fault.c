@@ -0,0 +1,184 @@
+/*******************************************************************************
+@file     fault.c
+@author   agent
+@date     18.10.2026
+@brief    Fault capture and warm restart for STM32F0xx.
+*******************************************************************************/
+
+#ifdef USE_FAULT
+
+#include "fault.h"
+#include "retain.h"
+#include <string.h>
+
+/*******************************************************************************
+ Specific definitions for the compiler
+ bounds of RAM from the linker: script.ld, or the scatter file (the STACK
+ region at the beginning of RAM) and startup.h (the initial stack pointer
+ at the end of RAM) of armcc / armclang
+*******************************************************************************/
+
+#if   defined(__ICCARM__)
+#error    USE_FAULT is not supported by the IAR toolchain
+#elif defined(__ARMCC_VERSION)
+extern char Image$$STACK$$Base[];
+extern char __initial_sp[];
+#define   RAM_start ((uint32_t) Image$$STACK$$Base)
+#define   RAM_end   ((uint32_t) __initial_sp)
+#else
+extern char __RAM_start[];
+extern char __RAM_end[];
+#define   RAM_start ((uint32_t) __RAM_start)
+#define   RAM_end   ((uint32_t) __RAM_end)
+#endif
+
+#define   FAULT_MAGIC   0x464C5421U
+
+/*******************************************************************************
+ Fault state
+*******************************************************************************/
+
+static fault_rec_t fault_last;  // record of the previous reset
+static bool        fault_valid;
+
+static RETAIN_NOINIT struct
+{
+	uint32_t    magic;
+	fault_rec_t rec;
+	uint32_t    check;
+
+}	fault_keep;
+
+/* -------------------------------------------------------------------------- */
+
+static
+uint32_t fault_check( void )
+{
+	return retain_check(&fault_keep.rec, sizeof(fault_keep.rec), FAULT_MAGIC);
+}
+
+/*******************************************************************************
+ HardFault and NMI: r0 = the exception frame, on the stack selected by EXC_RETURN,
+ r1 = 0 (the status is of _exit only)
+*******************************************************************************/
+
+#if defined(__ARMCC_VERSION) && (__ARMCC_VERSION < 6010050)
+
+__asm void HardFault_Handler( void )
+{
+	IMPORT  fault_save
+	MOVS    R0, #4
+	MOV     R1, LR
+	TST     R0, R1
+	MRS     R0, MSP
+	BEQ     fault_msp
+	MRS     R0, PSP
+fault_msp
+	MOVS    R1, #0
+	BL      fault_save
+}
+
+__asm void NMI_Handler( void )
+{
+	IMPORT  fault_save
+	MOVS    R0, #4
+	MOV     R1, LR
+	TST     R0, R1
+	MRS     R0, MSP
+	BEQ     fault_nmi
+	MRS     R0, PSP
+fault_nmi
+	MOVS    R1, #0
+	BL      fault_save
+}
+
+#else
+
+#define   FAULT_ENTRY \
+"	movs  r0, #4         \n" \
+"	mov   r1, lr         \n" \
+"	tst   r0, r1         \n" \
+"	mrs   r0, msp        \n" \
+"	beq   1f             \n" \
+"	mrs   r0, psp        \n" \
+"1:	movs  r1, #0         \n" \
+"	bl    fault_save     \n"
+
+__attribute__((naked))
+void HardFault_Handler( void )
+{
+	__ASM volatile (FAULT_ENTRY);
+}
+
+__attribute__((naked))
+void NMI_Handler( void )
+{
+	__ASM volatile (FAULT_ENTRY);
+}
+
+#endif
+
+/******************************************************************************/
+
+void fault_save( const uint32_t *frame, int status )
+{
+	uint32_t sp = (uint32_t) frame;
+	unsigned i;
+
+	__disable_irq();
+
+	memset(&fault_keep.rec, 0, sizeof(fault_keep.rec));
+
+	fault_keep.rec.cause  = __get_IPSR() & IPSR_ISR_Msk;
+	fault_keep.rec.status = status;
+	fault_keep.rec.tsk    = System.cur;
+	fault_keep.rec.count  = fault_valid ? fault_last.count + 1 : 1;
+
+	/* the frame is copied only if it lies in RAM (a stack overflow may be the cause) */
+	if (frame != NULL && sp >= RAM_start && sp + 32 <= RAM_end && (sp & 3) == 0)
+	{
+		fault_keep.rec.sp   = sp + 32;
+		fault_keep.rec.r0   = frame[0];
+		fault_keep.rec.r1   = frame[1];
+		fault_keep.rec.r2   = frame[2];
+		fault_keep.rec.r3   = frame[3];
+		fault_keep.rec.r12  = frame[4];
+		fault_keep.rec.lr   = frame[5];
+		fault_keep.rec.pc   = frame[6];
+		fault_keep.rec.xpsr = frame[7];
+		/* the stack was aligned to 8 bytes with an additional word */
+		if (frame[7] & (1U << 9))
+			fault_keep.rec.sp += 4;
+		for (i = 0; i < FAULT_STACK && sp + 32 + i * 4 < RAM_end; i++)
+			fault_keep.rec.stack[i] = frame[8 + i];
+	}
+
+	fault_keep.check = fault_check();
+	fault_keep.magic = FAULT_MAGIC;
+
+	NVIC_SystemReset();
+}
+
+/******************************************************************************/
+
+void fault_init( void )
+{
+	if (fault_keep.magic == FAULT_MAGIC && fault_keep.check == fault_check())
+	{
+		fault_last  = fault_keep.rec;
+		fault_valid = true;
+	}
+
+	fault_keep.magic = 0;
+}
+
+/******************************************************************************/
+
+const fault_rec_t *fault_record( void )
+{
+	return fault_valid ? &fault_last : NULL;
+}
+
+/******************************************************************************/
+
+#endif//USE_FAULT
@@ -0,0 +1,77 @@
+/*******************************************************************************
+@file     fault.h
+@author   agent
+@date     18.10.2026
+@brief    Fault capture and warm restart for STM32F0xx.
+          Enabled with USE_FAULT in DEFS.
+          HardFault and NMI save the stacked exception frame, the running
+          task and a short snapshot of the stack above the frame to retained
+          RAM and reset the system at once, within microseconds. An unhandled
+          interrupt (Fault_Handler) and _exit with a non-zero status are
+          recorded and restart the system the same way; exit(0) restarts the
+          system without a record (startup_stm32f0xx.c). The record of the
+          previous reset is taken over by fault_init.
+          The retained RAM (.noinit) must be reserved in the linker scripts.
+*******************************************************************************/
+
+#pragma once
+
+#include <os.h>
+#include <stm32f0xx.h>
+
+/*******************************************************************************
+ Configuration
+*******************************************************************************/
+
+#ifndef   FAULT_STACK
+#define   FAULT_STACK          8  // <- number of stack words saved above the exception frame
+#endif
+
+/*******************************************************************************
+ Fault record, kept in retained RAM over the reset
+*******************************************************************************/
+
+typedef struct __fault_rec
+{
+	unsigned  cause;   // exception number: 2 NMI, 3 HardFault, 16+ unhandled interrupt, 0 _exit
+	int       status;  // status of _exit
+	tsk_t    *tsk;     // running task
+	uint32_t  sp;      // stack pointer before the exception, 0 if not known
+	uint32_t  r0, r1, r2, r3, r12, lr, pc, xpsr; // exception frame (cause 2 or 3)
+	uint32_t  stack[FAULT_STACK]; // stack above the frame
+	unsigned  count;   // number of consecutive fault resets
+
+}	fault_rec_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*******************************************************************************
+ Take over the record of the previous reset; call once at the beginning
+ of the application
+*******************************************************************************/
+
+void      fault_init( void );
+
+/*******************************************************************************
+ Record of the previous reset, if caused by a fault
+ return: pointer to the record, NULL if the previous reset had other cause
+*******************************************************************************/
+
+const
+fault_rec_t*fault_record( void );
+
+/*******************************************************************************
+ Save the record and reset the system; 'frame': the exception frame or NULL
+ called by the fault handlers
+*******************************************************************************/
+
+__NO_RETURN
+void      fault_save( const uint32_t *frame, int status );
+
+#ifdef __cplusplus
+}
+#endif
+
+/******************************************************************************/
@@ -0,0 +1,514 @@
+/*******************************************************************************
+@file     kvs.c
+@author   agent
+@date     18.10.2026
+@brief    Log-structured key-value store in the on-chip flash of STM32F0xx.
+*******************************************************************************/
+
+#ifdef USE_KVS
+
+#include "kvs.h"
+#include <string.h>
+
+#if       KVS_PAGES < 3
+#error    KVS_PAGES must be at least 3!
+#endif
+#if       KVS_PAGES * KVS_PAGE > 0x10000
+#error    The store must not exceed 64KB!
+#endif
+#if       defined(KVS_RESERVED) && KVS_RESERVED != KVS_PAGES
+#error    KVS_PAGES differs from the flash pages reserved by the linker (give KVS_PAGES in DEFS)!
+#endif
+#if       KVS_KEYS > 255 || KVS_VALUE > 255
+#error    Invalid KVS_KEYS or KVS_VALUE value!
+#endif
+
+/*******************************************************************************
+ Flash layout (half-words, erased state: 0xFFFF)
+ page header: sequence number, magic (programmed last: the page is opened)
+ record:      key << 8 | size, value (padded with 0xFF), checksum (programmed
+              last: the record is committed); size 0: the key was removed
+ the pages form a circular log from the oldest (tail) to the newest (head)
+*******************************************************************************/
+
+#define   KVS_MAGIC     0x4B56U
+#define   KVS_HEAD      4U
+#define   KVS_ALIGN(n)  (((n) + 1U) & ~1U)
+#define   KVS_SIZE(n)   (KVS_ALIGN(n) + 4U)
+#define   KVS_SPARE     2U // <- erased pages kept by the compaction task
+#define   KVS_LIMIT    ((KVS_PAGES - 2) * (KVS_PAGE - KVS_HEAD - KVS_SIZE(KVS_VALUE)))
+
+#define   KVS_PTR(off)  ((volatile uint16_t *)(KVS_ORIGIN + (off)))
+
+/*******************************************************************************
+ Store state
+*******************************************************************************/
+
+static uint16_t kvs_index[KVS_KEYS]; // offset of the latest record of the key, 0 if none
+static unsigned kvs_head;            // newest page
+static unsigned kvs_tail;            // oldest page
+static unsigned kvs_wr;              // offset of the first free half-word in the head page
+static unsigned kvs_live;            // total size of the live records
+static uint16_t kvs_seq;             // sequence number of the head page
+
+static_SEM(kvs_lock, 1, semBinary);
+static_SEM(kvs_gc,   0, semBinary);
+
+static void kvs_collector( void );
+
+static_TSK(kvs_task, KVS_PRIO, kvs_collector);
+
+/*******************************************************************************
+ Flash operations
+*******************************************************************************/
+
+static
+void kvs_enter( void )
+{
+	sem_wait(kvs_lock);
+
+	if (FLASH->CR & FLASH_CR_LOCK)
+	{
+		FLASH->KEYR = FLASH_KEY1;
+		FLASH->KEYR = FLASH_KEY2;
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+static
+void kvs_leave( void )
+{
+	FLASH->CR |= FLASH_CR_LOCK;
+
+	sem_give(kvs_lock);
+}
+
+/* -------------------------------------------------------------------------- */
+
+static
+bool kvs_program( unsigned off, uint16_t val )
+{
+	FLASH->CR |= FLASH_CR_PG;
+	*KVS_PTR(off) = val;
+	while (FLASH->SR & FLASH_SR_BSY);
+	FLASH->CR &= ~FLASH_CR_PG;
+	FLASH->SR  = FLASH_SR_EOP | FLASH_SR_PGERR | FLASH_SR_WRPRTERR;
+
+	return *KVS_PTR(off) == val;
+}
+
+/* -------------------------------------------------------------------------- */
+
+static
+bool kvs_blank( unsigned page )
+{
+	const volatile uint32_t *ptr = (const volatile uint32_t *) KVS_PTR(page * KVS_PAGE);
+	unsigned cnt;
+
+	for (cnt = KVS_PAGE / 4; cnt > 0; cnt--)
+		if (*ptr++ != 0xFFFFFFFFU)
+			return false;
+
+	return true;
+}
+
+/* -------------------------------------------------------------------------- */
+
+static
+bool kvs_erase( unsigned page )
+{
+	FLASH->CR |= FLASH_CR_PER;
+	FLASH->AR  = KVS_ORIGIN + page * KVS_PAGE;
+	FLASH->CR |= FLASH_CR_STRT;
+	while (FLASH->SR & FLASH_SR_BSY);
+	FLASH->CR &= ~FLASH_CR_PER;
+	FLASH->SR  = FLASH_SR_EOP | FLASH_SR_PGERR | FLASH_SR_WRPRTERR;
+
+	return kvs_blank(page);
+}
+
+/*******************************************************************************
+ Log
+*******************************************************************************/
+
+static inline
+unsigned kvs_next( unsigned page )
+{
+	return page + 1 < KVS_PAGES ? page + 1 : 0;
+}
+
+static inline
+unsigned kvs_prev( unsigned page )
+{
+	return page > 0 ? page - 1 : KVS_PAGES - 1;
+}
+
+static inline
+unsigned kvs_free( void )
+{
+	return kvs_head >= kvs_tail ? KVS_PAGES - 1 - kvs_head + kvs_tail : kvs_tail - kvs_head - 1;
+}
+
+static inline
+bool kvs_room( unsigned size )
+{
+	return kvs_wr + size <= (kvs_head + 1) * KVS_PAGE;
+}
+
+static inline
+uint16_t kvs_step( uint16_t sum, uint16_t val )
+{
+	return (uint16_t)(((sum << 5) | (sum >> 11)) + val);
+}
+
+static inline
+uint16_t kvs_final( uint16_t sum )
+{
+	return sum == 0xFFFF ? 0 : sum; // never looks like an erased half-word
+}
+
+/* -------------------------------------------------------------------------- */
+/* program the header of the page and make it the head of the log */
+
+static
+bool kvs_start( unsigned page, uint16_t seq )
+{
+	if (!kvs_program(page * KVS_PAGE, seq) || !kvs_program(page * KVS_PAGE + 2, KVS_MAGIC))
+	{
+		kvs_erase(page);
+		return false;
+	}
+
+	kvs_head = page;
+	kvs_seq  = seq;
+	kvs_wr   = page * KVS_PAGE + KVS_HEAD;
+
+	return true;
+}
+
+/* -------------------------------------------------------------------------- */
+
+static
+bool kvs_open( void )
+{
+	if (kvs_free() == 0 || !kvs_start(kvs_next(kvs_head), kvs_seq + 1))
+		return false;
+
+	if (kvs_free() < KVS_SPARE)
+		sem_give(kvs_gc);
+
+	return true;
+}
+
+/* -------------------------------------------------------------------------- */
+/* size of the live record of the key */
+
+static inline
+unsigned kvs_used( unsigned key )
+{
+	unsigned off = kvs_index[key];
+	unsigned len = off ? *KVS_PTR(off) & 0xFF : 0;
+
+	return len ? KVS_SIZE(len) : 0;
+}
+
+/* -------------------------------------------------------------------------- */
+/* make the record at 'off' the latest one of its key */
+
+static
+void kvs_update( unsigned key, unsigned off )
+{
+	unsigned len = *KVS_PTR(off) & 0xFF;
+
+	kvs_live -= kvs_used(key);
+
+	if (len)
+		kvs_live += KVS_SIZE(len);
+
+	kvs_index[key] = (uint16_t) off;
+}
+
+/* -------------------------------------------------------------------------- */
+/* the head page must have room for the record; 'data' may point to the flash */
+
+static
+bool kvs_append( unsigned key, const uint8_t *data, unsigned len )
+{
+	unsigned off = kvs_wr;
+	uint16_t val = (uint16_t)(key << 8 | len);
+	uint16_t sum = kvs_step(KVS_MAGIC, val);
+	bool     ok  = kvs_program(off, val);
+	unsigned i;
+
+	/* the space is used even if the record fails */
+	kvs_wr += KVS_SIZE(len);
+
+	for (i = 0; ok && i < len; i += 2)
+	{
+		val = (uint16_t)(data[i] | (i + 1 < len ? data[i + 1] : 0xFF) << 8);
+		sum = kvs_step(sum, val);
+		ok  = kvs_program(off + 2 + i, val);
+	}
+
+	if (!ok || !kvs_program(off + 2 + KVS_ALIGN(len), kvs_final(sum)))
+		return false;
+
+	kvs_update(key, off);
+	return true;
+}
+
+/* -------------------------------------------------------------------------- */
+
+static
+bool kvs_valid( unsigned off, unsigned len )
+{
+	uint16_t sum = kvs_step(KVS_MAGIC, *KVS_PTR(off));
+	unsigned i;
+
+	for (i = 0; i < len; i += 2)
+		sum = kvs_step(sum, *KVS_PTR(off + 2 + i));
+
+	return *KVS_PTR(off + 2 + KVS_ALIGN(len)) == kvs_final(sum);
+}
+
+/* -------------------------------------------------------------------------- */
+/* return the size of the record at 'off' or 0 if the page ends here */
+
+static
+unsigned kvs_record( unsigned off, unsigned *key, unsigned *len )
+{
+	unsigned end = (off / KVS_PAGE + 1) * KVS_PAGE;
+	unsigned val = *KVS_PTR(off);
+
+	*key = val >> 8;
+	*len = val & 0xFF;
+
+	if (val == 0xFFFF || *key >= KVS_KEYS || *len > KVS_VALUE || off + KVS_SIZE(*len) > end)
+		return 0;
+
+	return KVS_SIZE(*len);
+}
+
+/* -------------------------------------------------------------------------- */
+/* add the committed records of the page to the index; return the end of the records */
+
+static
+unsigned kvs_scan( unsigned page )
+{
+	unsigned end = (page + 1) * KVS_PAGE;
+	unsigned off = page * KVS_PAGE + KVS_HEAD;
+	unsigned key, len, size;
+
+	while (off < end)
+	{
+		size = kvs_record(off, &key, &len);
+		if (size == 0)
+			/* anything but the erased flash closes the page */
+			return *KVS_PTR(off) == 0xFFFF ? off : end;
+
+		if (kvs_valid(off, len))
+			kvs_update(key, off);
+
+		off += size;
+	}
+
+	return end;
+}
+
+/* -------------------------------------------------------------------------- */
+/* move the live records of the oldest page to the head and erase it */
+
+static
+bool kvs_compact( void )
+{
+	unsigned page, off, end;
+	unsigned key, len, size;
+
+	if (kvs_tail == kvs_head && !kvs_open())
+		return false;
+
+	page = kvs_tail;
+	end  = (page + 1) * KVS_PAGE;
+
+	for (off = page * KVS_PAGE + KVS_HEAD; off < end; off += size)
+	{
+		size = kvs_record(off, &key, &len);
+		if (size == 0)
+			break;
+
+		if (kvs_index[key] != off)
+			continue;
+
+		if (len == 0)
+		{
+			/* there are no older records of the removed key */
+			kvs_index[key] = 0;
+			continue;
+		}
+
+		if (!kvs_room(size) && !kvs_open())
+			return false;
+
+		if (!kvs_append(key, (const uint8_t *) KVS_PTR(off + 2), len))
+			return false;
+	}
+
+	/* an interrupted erase leaves an invalid page, cleaned up by kvs_init */
+	kvs_program(page * KVS_PAGE + 2, 0x0000);
+	kvs_tail = kvs_next(page);
+
+	return kvs_erase(page);
+}
+
+/* -------------------------------------------------------------------------- */
+
+static
+void kvs_collector( void )
+{
+	unsigned cnt;
+	bool     done;
+
+	for (;;)
+	{
+		sem_wait(kvs_gc);
+
+		/* the lock is released between pages, the writers can run in between */
+		for (cnt = 0, done = false; !done && cnt < KVS_PAGES; cnt++)
+		{
+			kvs_enter();
+			done = kvs_free() >= KVS_SPARE || !kvs_compact();
+			kvs_leave();
+		}
+	}
+}
+
+/******************************************************************************/
+
+void kvs_init( void )
+{
+	bool     valid[KVS_PAGES];
+	uint16_t seq[KVS_PAGES];
+	unsigned page, head = KVS_PAGES;
+
+	kvs_enter();
+
+	memset(kvs_index, 0, sizeof(kvs_index));
+	kvs_live = 0;
+
+	for (page = 0; page < KVS_PAGES; page++)
+	{
+		seq[page]   = *KVS_PTR(page * KVS_PAGE);
+		valid[page] = *KVS_PTR(page * KVS_PAGE + 2) == KVS_MAGIC;
+
+		if (valid[page])
+		{
+			if (head == KVS_PAGES || (int16_t)(seq[page] - seq[head]) > 0)
+				head = page;
+		}
+		else
+		if (!kvs_blank(page))
+		{
+			/* interrupted opening or erase of the page */
+			kvs_erase(page);
+		}
+	}
+
+	if (head == KVS_PAGES)
+	{
+		kvs_tail = 0;
+		kvs_start(0, 0);
+	}
+	else
+	{
+		/* the log: consecutive sequence numbers ending at the newest page */
+		kvs_tail = head;
+		while (kvs_prev(kvs_tail) != head && valid[kvs_prev(kvs_tail)] && seq[kvs_prev(kvs_tail)] == (uint16_t)(seq[kvs_tail] - 1))
+			kvs_tail = kvs_prev(kvs_tail);
+
+		for (page = kvs_next(head); page != kvs_tail; page = kvs_next(page))
+			if (valid[page])
+				kvs_erase(page);
+
+		for (page = kvs_tail; page != head; page = kvs_next(page))
+			kvs_scan(page);
+
+		kvs_head = head;
+		kvs_seq  = seq[head];
+		kvs_wr   = kvs_scan(head);
+	}
+
+	kvs_leave();
+
+	tsk_start(kvs_task);
+
+	if (kvs_free() < KVS_SPARE)
+		sem_give(kvs_gc);
+}
+
+/******************************************************************************/
+
+unsigned kvs_write( unsigned key, const void *data, unsigned size )
+{
+	unsigned need = KVS_SIZE(size);
+	unsigned live, cnt;
+	bool     ok = true;
+
+	if (key >= KVS_KEYS || size > KVS_VALUE || (size > 0 && data == NULL))
+		return E_FAILURE;
+
+	kvs_enter();
+
+	live = kvs_live - kvs_used(key) + (size ? need : 0);
+
+	if (size == 0 && kvs_used(key) == 0)
+		ok = true; // nothing to remove
+	else
+	if (live > KVS_LIMIT)
+		ok = false;
+	else
+	{
+		/* a page is compacted here only if the compaction task is falling behind */
+		for (cnt = 0; ok && !kvs_room(need); cnt++)
+			ok = kvs_free() >= KVS_SPARE ? kvs_open() : cnt < KVS_PAGES && kvs_compact();
+
+		ok = ok && kvs_append(key, data, size);
+	}
+
+	kvs_leave();
+
+	return ok ? E_SUCCESS : E_FAILURE;
+}
+
+/******************************************************************************/
+
+unsigned kvs_delete( unsigned key )
+{
+	return kvs_write(key, NULL, 0);
+}
+
+/******************************************************************************/
+
+unsigned kvs_read( unsigned key, void *data, unsigned size )
+{
+	unsigned len = 0;
+
+	if (key >= KVS_KEYS)
+		return 0;
+
+	kvs_enter();
+
+	if (kvs_index[key])
+	{
+		len = *KVS_PTR(kvs_index[key]) & 0xFF;
+		memcpy(data, (const void *) KVS_PTR(kvs_index[key] + 2), size < len ? size : len);
+	}
+
+	kvs_leave();
+
+	return len;
+}
+
+/******************************************************************************/
+
+#endif//USE_KVS
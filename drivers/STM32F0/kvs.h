@@ -0,0 +1,89 @@
+/*******************************************************************************
+@file     kvs.h
+@author   agent
+@date     18.10.2026
+@brief    Log-structured key-value store in the on-chip flash of STM32F0xx.
+          Enabled with USE_KVS in DEFS.
+          Records are appended to a circular log of flash pages with half-word
+          programming; a RAM index gives the location of the latest record
+          of each key, a low priority task erases the oldest page after
+          moving its live records to the head of the log.
+          The store survives a power failure at any moment: an incomplete
+          record or page operation is detected and ignored by kvs_init.
+*******************************************************************************/
+
+#pragma once
+
+#include <os.h>
+#include <stm32f0xx.h>
+
+/*******************************************************************************
+ Configuration
+ the makefiles reserve the top KVS_PAGES pages of the flash with USE_KVS
+ (KVS_PAGES=n in DEFS) and pass the number of reserved pages as KVS_RESERVED
+*******************************************************************************/
+
+#ifndef   KVS_PAGES
+#define   KVS_PAGES            4  // <- number of flash pages used by the store, at least 3
+#endif
+#ifndef   KVS_PAGE
+#if defined(STM32F030xC) || defined(STM32F070xB) || defined(STM32F071xB) || defined(STM32F072xB) || \
+    defined(STM32F078xx) || defined(STM32F091xC) || defined(STM32F098xx)
+#define   KVS_PAGE          2048  // <- size of the flash page
+#else
+#define   KVS_PAGE          1024  // <- size of the flash page
+#endif
+#endif
+#ifndef   KVS_ORIGIN
+#define   KVS_ORIGIN (FLASH_BANK1_END + 1 - KVS_PAGES * KVS_PAGE) // <- address of the first page of the store
+#endif
+#ifndef   KVS_KEYS
+#define   KVS_KEYS            32  // <- keys: 0 .. KVS_KEYS-1, at most 255
+#endif
+#ifndef   KVS_VALUE
+#define   KVS_VALUE           64  // <- maximum size of the value in bytes, at most 255
+#endif
+#ifndef   KVS_PRIO
+#define   KVS_PRIO             1  // <- priority of the compaction task
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*******************************************************************************
+ Rebuild the index from the flash contents, clean up after an interrupted
+ operation and start the compaction task; call once before using the store
+*******************************************************************************/
+
+void      kvs_init( void );
+
+/*******************************************************************************
+ Store the value of the key; not for interrupt handlers
+ the cpu is stalled while the flash is programmed or erased (page erase:
+ up to 40ms), interrupt handlers executed from the flash included;
+ a page is erased here only if the compaction task is falling behind
+ return: E_SUCCESS, E_FAILURE (invalid parameters, store full or flash error)
+*******************************************************************************/
+
+unsigned  kvs_write( unsigned key, const void *data, unsigned size );
+
+/*******************************************************************************
+ Remove the key from the store
+ return: E_SUCCESS, E_FAILURE
+*******************************************************************************/
+
+unsigned  kvs_delete( unsigned key );
+
+/*******************************************************************************
+ Read the value of the key, at most 'size' bytes are copied
+ return: size of the stored value, 0 if the key was not found
+*******************************************************************************/
+
+unsigned  kvs_read( unsigned key, void *data, unsigned size );
+
+#ifdef __cplusplus
+}
+#endif
+
+/******************************************************************************/
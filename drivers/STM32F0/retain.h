@@ -0,0 +1,55 @@
+/*******************************************************************************
+@file     retain.h
+@author   agent
+@date     19.10.2026
+@brief    Records kept in retained RAM over a warm reset (fault.h, wdg.h).
+          The retained RAM (.noinit) is not initialized by the startup code
+          and must be reserved in the linker scripts; a record is valid only
+          if its magic number and its checksum match.
+*******************************************************************************/
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*******************************************************************************
+ Specific definitions for the compiler
+ retained RAM: not initialized by the startup code
+*******************************************************************************/
+
+#if   defined(__ICCARM__)
+#define   RETAIN_NOINIT  __no_init
+#elif defined(__ARMCC_VERSION) && (__ARMCC_VERSION < 6010050)
+#define   RETAIN_NOINIT  __attribute__((section(".bss.noinit"), zero_init))
+#else
+#define   RETAIN_NOINIT  __attribute__((section(".bss.noinit")))
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*******************************************************************************
+ Checksum of the record 'data' of 'size' bytes (a multiple of 4), seeded with
+ the magic number of the record
+*******************************************************************************/
+
+static inline
+uint32_t retain_check( const void *data, size_t size, uint32_t magic )
+{
+	const uint32_t *ptr = (const uint32_t *) data;
+	uint32_t        sum = magic;
+	size_t          i;
+
+	for (i = 0; i < size / sizeof(uint32_t); i++)
+		sum = (sum << 1 | sum >> 31) ^ ptr[i];
+
+	return sum;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+/******************************************************************************/
@@ -0,0 +1,177 @@
+/*******************************************************************************
+@file     spi.c
+@author   agent
+@date     18.10.2026
+@brief    DMA driven SPI2 master driver with transaction queue for STM32F0xx.
+*******************************************************************************/
+
+#ifdef USE_SPI
+
+#include "spi.h"
+
+/*******************************************************************************
+ Driver state
+*******************************************************************************/
+
+static struct
+{
+	spi_trn_t * head;   // transaction in progress
+	spi_trn_t * tail;   // last queued transaction
+	unsigned    div;    // cpu cycles per SCK cycle
+	uint32_t    bytes;  // bytes transferred since the last spi_load
+	cnt_t       mark;   // time of the last spi_load
+
+}	spi;
+
+static const uint8_t spi_fill = 0xFF;
+static       uint8_t spi_drop;
+
+/* -------------------------------------------------------------------------- */
+
+static
+void spi_start( spi_trn_t *trn )
+{
+	if (trn->port != NULL)
+		trn->port->BRR = trn->pin;
+
+	/* RX channel first, so no received byte is lost */
+	DMA1_Channel4->CMAR  = trn->rx ? (uint32_t) trn->rx : (uint32_t) &spi_drop;
+	DMA1_Channel4->CNDTR = trn->size;
+	DMA1_Channel4->CCR   = (trn->rx ? DMA_CCR_MINC : 0) | DMA_CCR_TCIE | DMA_CCR_EN;
+
+	DMA1_Channel5->CMAR  = trn->tx ? (uint32_t) trn->tx : (uint32_t) &spi_fill;
+	DMA1_Channel5->CNDTR = trn->size;
+	DMA1_Channel5->CCR   = (trn->tx ? DMA_CCR_MINC : 0) | DMA_CCR_DIR | DMA_CCR_EN;
+}
+
+/******************************************************************************/
+
+void spi_init( unsigned frequency )
+{
+	unsigned br = 0;
+
+	while (br < 7 && ((unsigned) CPU_FREQUENCY >> (br + 1)) > frequency)
+		br++;
+
+	RCC->AHBENR  |= RCC_AHBENR_DMA1EN | RCC_AHBENR_GPIOBEN;
+	RCC->APB1ENR |= RCC_APB1ENR_SPI2EN;
+
+	/* PB13 (SCK), PB14 (MISO), PB15 (MOSI) in alternate function 0 */
+	GPIOB->MODER   = (GPIOB->MODER & ~(GPIO_MODER_MODER13 | GPIO_MODER_MODER14 | GPIO_MODER_MODER15)) | GPIO_MODER_MODER13_1 | GPIO_MODER_MODER14_1 | GPIO_MODER_MODER15_1;
+	GPIOB->OSPEEDR|= GPIO_OSPEEDR_OSPEEDR13 | GPIO_OSPEEDR_OSPEEDR15;
+	GPIOB->AFR[1] &= ~(GPIO_AFRH_AFRH5 | GPIO_AFRH_AFRH6 | GPIO_AFRH_AFRH7);
+
+	DMA1_Channel4->CCR  = 0;
+	DMA1_Channel4->CPAR = (uint32_t) &SPI2->DR;
+	DMA1_Channel5->CCR  = 0;
+	DMA1_Channel5->CPAR = (uint32_t) &SPI2->DR;
+
+	SPI2->CR1 = 0;
+	SPI2->CR2 = SPI_CR2_FRXTH | (7U << SPI_CR2_DS_Pos) | SPI_CR2_RXDMAEN | SPI_CR2_TXDMAEN;
+	SPI2->CR1 = (br << SPI_CR1_BR_Pos) | SPI_CR1_SSM | SPI_CR1_SSI | SPI_CR1_MSTR | SPI_CR1_SPE;
+
+	sys_lock();
+	spi.head  = spi.tail = NULL;
+	spi.div   = 2U << br;
+	spi.bytes = 0;
+	spi.mark  = sys_time();
+	sys_unlock();
+
+	NVIC_EnableIRQ(DMA1_Channel4_5_IRQn);
+}
+
+/******************************************************************************/
+
+void spi_submit( spi_trn_t *trn )
+{
+	trn->next = NULL;
+
+	sys_lock();
+	if (spi.head == NULL)
+	{
+		spi.head = spi.tail = trn;
+		spi_start(trn);
+	}
+	else
+	{
+		spi.tail->next = trn;
+		spi.tail = trn;
+	}
+	sys_unlock();
+}
+
+/******************************************************************************/
+
+void spi_transfer( spi_trn_t *trn )
+{
+	sem_t sem;
+
+	sem_init(&sem, 0, semBinary);
+	trn->sem = &sem;
+	spi_submit(trn);
+	sem_wait(&sem);
+}
+
+/******************************************************************************/
+
+unsigned spi_load( void )
+{
+	uint32_t bytes;
+	cnt_t    time;
+	uint64_t busy;
+	uint64_t total;
+
+	sys_lock();
+	bytes = spi.bytes;
+	spi.bytes = 0;
+	time = sys_time() - spi.mark;
+	spi.mark += time;
+	sys_unlock();
+
+	busy  = (uint64_t) bytes * 8U * spi.div;
+	total = (uint64_t) time * (CPU_FREQUENCY / OS_FREQUENCY);
+
+	if (total == 0)
+		return 0;
+	if (busy >= total)
+		return 10000U;
+
+	return (unsigned)(busy * 10000U / total);
+}
+
+/*******************************************************************************
+ Interrupt handler
+*******************************************************************************/
+
+void DMA1_Channel4_5_IRQHandler( void )
+{
+	spi_trn_t *trn = spi.head;
+
+	if ((DMA1->ISR & DMA_ISR_TCIF4) == 0 || trn == NULL)
+		return;
+
+	DMA1->IFCR = DMA_IFCR_CGIF4 | DMA_IFCR_CGIF5;
+	DMA1_Channel4->CCR = 0;
+	DMA1_Channel5->CCR = 0;
+
+	if (trn->port != NULL)
+		trn->port->BSRR = trn->pin;
+
+	spi.bytes += trn->size;
+
+	/* chain the next transaction before notifying the owner of this one */
+	spi.head = trn->next;
+	if (spi.head != NULL)
+		spi_start(spi.head);
+	else
+		spi.tail = NULL;
+
+	if (trn->done != NULL)
+		trn->done(trn);
+	if (trn->sem != NULL)
+		sem_giveISR(trn->sem);
+}
+
+/******************************************************************************/
+
+#endif//USE_SPI
@@ -0,0 +1,70 @@
+/*******************************************************************************
+@file     spi.h
+@author   agent
+@date     18.10.2026
+@brief    DMA driven SPI2 master driver with transaction queue for STM32F0xx.
+          Enabled with USE_SPI in DEFS.
+          SCK: PB13, MISO: PB14, MOSI: PB15, DMA1 channel 4 (RX) and 5 (TX).
+*******************************************************************************/
+
+#pragma once
+
+#include <os.h>
+#include <stm32f0xx.h>
+
+/*******************************************************************************
+ Transaction descriptor
+ the descriptor and its buffers belong to the driver from spi_submit until
+ the transaction is completed; then 'done' is called from the interrupt
+ handler and 'sem' (if not NULL) is released
+*******************************************************************************/
+
+typedef struct __spi_trn spi_trn_t;
+
+struct __spi_trn
+{
+	spi_trn_t    * next;     // used by the driver
+	GPIO_TypeDef * port;     // chip select port, NULL if not used
+	uint16_t       pin;      // chip select pin mask (active low)
+	const void   * tx;       // data to send, NULL => 0xFF is sent
+	void         * rx;       // buffer for received data, NULL => discarded
+	unsigned       size;     // number of bytes to transfer
+	void        (* done)( spi_trn_t * ); // completion callback, may be NULL
+	sem_t        * sem;      // completion semaphore, may be NULL
+};
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*******************************************************************************
+ Initialize SPI2 as master, mode 0, 8-bit frames, msb first
+ frequency: the highest acceptable SCK frequency in Hz
+*******************************************************************************/
+
+void     spi_init( unsigned frequency );
+
+/*******************************************************************************
+ Append the transaction to the queue; may be called from interrupt handlers
+ queued transactions are chained back-to-back from the DMA interrupt
+*******************************************************************************/
+
+void     spi_submit( spi_trn_t *trn );
+
+/*******************************************************************************
+ Submit the transaction and wait for its completion (trn->sem is overwritten)
+*******************************************************************************/
+
+void     spi_transfer( spi_trn_t *trn );
+
+/*******************************************************************************
+ Bus utilisation since the previous call, in hundredths of a percent
+*******************************************************************************/
+
+unsigned spi_load( void );
+
+#ifdef __cplusplus
+}
+#endif
+
+/******************************************************************************/
@@ -0,0 +1,199 @@
+/*******************************************************************************
+@file     usart.c
+@author   agent
+@date     18.10.2026
+@brief    DMA driven USART1 driver for STM32F0xx.
+*******************************************************************************/
+
+#ifdef USE_USART
+
+#include "usart.h"
+#include <string.h>
+
+/*******************************************************************************
+ Driver state
+*******************************************************************************/
+
+#if       USART_RX_SIZE < 2 || (USART_RX_SIZE & (USART_RX_SIZE - 1)) != 0
+#error    USART_RX_SIZE must be a power of 2!
+#endif
+
+static uint8_t           usart_rx[USART_RX_SIZE];
+static volatile unsigned usart_rcvd; // bytes received up to the last half of the buffer
+static unsigned          usart_tail; // bytes read
+static unsigned          usart_drop; // bytes overwritten before they were read
+
+static_SEM(usart_rxs, 0, semBinary); // new data in the receive buffer
+static_SEM(usart_txs, 0, semBinary); // transmission completed
+static_SEM(usart_txl, 1, semBinary); // transmitter owner lock
+
+/* -------------------------------------------------------------------------- */
+
+__STATIC_INLINE
+unsigned usart_head( void )
+{
+	unsigned head = USART_RX_SIZE - DMA1_Channel3->CNDTR;
+	return head < USART_RX_SIZE ? head : 0;
+}
+
+/* -------------------------------------------------------------------------- */
+/* bytes received; usart_rcvd is read before the position of the DMA, so the
+   position is never behind it even if the interrupt comes in between */
+
+static
+unsigned usart_count( void )
+{
+	unsigned rcvd = usart_rcvd;
+	return rcvd + (usart_head() - rcvd) % USART_RX_SIZE;
+}
+
+/******************************************************************************/
+
+void usart_init( unsigned baudrate )
+{
+	RCC->AHBENR  |= RCC_AHBENR_DMA1EN | RCC_AHBENR_GPIOAEN;
+	RCC->APB2ENR |= RCC_APB2ENR_USART1EN;
+
+	/* PA9 (TX) and PA10 (RX) in alternate function 1 */
+	GPIOA->MODER   = (GPIOA->MODER & ~(GPIO_MODER_MODER9 | GPIO_MODER_MODER10)) | GPIO_MODER_MODER9_1 | GPIO_MODER_MODER10_1;
+	GPIOA->OSPEEDR|= GPIO_OSPEEDR_OSPEEDR9 | GPIO_OSPEEDR_OSPEEDR10;
+	GPIOA->AFR[1]  = (GPIOA->AFR[1] & ~(GPIO_AFRH_AFRH1 | GPIO_AFRH_AFRH2)) | (1U << GPIO_AFRH_AFRH1_Pos) | (1U << GPIO_AFRH_AFRH2_Pos);
+
+	/* RX: circular buffer, half and full transfer interrupts */
+	DMA1_Channel3->CCR   = 0;
+	DMA1_Channel3->CPAR  = (uint32_t) &USART1->RDR;
+	DMA1_Channel3->CMAR  = (uint32_t)  usart_rx;
+	DMA1_Channel3->CNDTR = USART_RX_SIZE;
+	DMA1_Channel3->CCR   = DMA_CCR_MINC | DMA_CCR_CIRC | DMA_CCR_HTIE | DMA_CCR_TCIE | DMA_CCR_EN;
+
+	/* TX: memory to peripheral, started by usart_write */
+	DMA1_Channel2->CCR   = 0;
+	DMA1_Channel2->CPAR  = (uint32_t) &USART1->TDR;
+	DMA1_Channel2->CCR   = DMA_CCR_MINC | DMA_CCR_DIR | DMA_CCR_TCIE;
+
+	usart_rcvd = 0;
+	usart_tail = 0;
+	usart_drop = 0;
+
+	USART1->CR1 = 0;
+	USART1->BRR = (CPU_FREQUENCY + baudrate / 2) / baudrate;
+	USART1->CR3 = USART_CR3_DMAR | USART_CR3_DMAT | USART_CR3_OVRDIS;
+	USART1->ICR = USART_ICR_IDLECF;
+	USART1->CR1 = USART_CR1_IDLEIE | USART_CR1_TE | USART_CR1_RE | USART_CR1_UE;
+
+	NVIC_EnableIRQ(USART1_IRQn);
+	NVIC_EnableIRQ(DMA1_Channel2_3_IRQn);
+}
+
+/******************************************************************************/
+
+unsigned usart_read( void *data, unsigned size, cnt_t delay )
+{
+	uint8_t *buf = data;
+	unsigned head;
+	unsigned pos;
+	unsigned len;
+	unsigned cnt;
+
+	while ((head = usart_count()) == usart_tail)
+		if (sem_waitFor(usart_rxs, delay) != E_SUCCESS)
+			return 0;
+
+	if (head - usart_tail >= USART_RX_SIZE)
+	{
+		/* the reader did not keep up and the DMA wrapped over the unread data;
+		   keep the half of the buffer last written, the rest is lost */
+		usart_drop += head - USART_RX_SIZE / 2 - usart_tail;
+		usart_tail  = head - USART_RX_SIZE / 2;
+	}
+
+	len = head - usart_tail;
+	if (len > size) len = size;
+
+	pos = usart_tail % USART_RX_SIZE;
+	cnt = USART_RX_SIZE - pos;
+	if (cnt > len) cnt = len;
+
+	memcpy(buf, usart_rx + pos, cnt);
+	memcpy(buf + cnt, usart_rx, len - cnt);
+	usart_tail += len;
+
+	return len;
+}
+
+/******************************************************************************/
+
+unsigned usart_lost( void )
+{
+	return usart_drop;
+}
+
+/******************************************************************************/
+
+unsigned usart_write( const void *data, unsigned size, cnt_t delay )
+{
+	unsigned event;
+
+	if (size == 0)
+		return E_SUCCESS;
+
+	event = sem_waitFor(usart_txl, delay);
+	if (event != E_SUCCESS)
+		return event;
+
+	DMA1_Channel2->CMAR  = (uint32_t) data;
+	DMA1_Channel2->CNDTR = size;
+	DMA1_Channel2->CCR  |= DMA_CCR_EN;
+
+	event = sem_waitFor(usart_txs, delay);
+	if (event != E_SUCCESS)
+	{
+		/* abort the transfer and drop a completion signalled in the meantime */
+		DMA1_Channel2->CCR &= ~DMA_CCR_EN;
+		DMA1->IFCR = DMA_IFCR_CGIF2;
+		sem_take(usart_txs);
+	}
+
+	sem_give(usart_txl);
+	return event;
+}
+
+/*******************************************************************************
+ Interrupt handlers
+*******************************************************************************/
+
+void USART1_IRQHandler( void )
+{
+	if (USART1->ISR & USART_ISR_IDLE)
+	{
+		USART1->ICR = USART_ICR_IDLECF;
+		sem_giveISR(usart_rxs);
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+void DMA1_Channel2_3_IRQHandler( void )
+{
+	uint32_t isr = DMA1->ISR;
+
+	if (isr & DMA_ISR_TCIF2)
+	{
+		DMA1->IFCR = DMA_IFCR_CGIF2;
+		DMA1_Channel2->CCR &= ~DMA_CCR_EN;
+		sem_giveISR(usart_txs);
+	}
+
+	if (isr & (DMA_ISR_HTIF3 | DMA_ISR_TCIF3))
+	{
+		DMA1->IFCR = DMA_IFCR_CGIF3;
+		/* each flag is the end of one half of the buffer, both may be pending */
+		if (isr & DMA_ISR_HTIF3) usart_rcvd += USART_RX_SIZE / 2;
+		if (isr & DMA_ISR_TCIF3) usart_rcvd += USART_RX_SIZE / 2;
+		sem_giveISR(usart_rxs);
+	}
+}
+
+/******************************************************************************/
+
+#endif//USE_USART
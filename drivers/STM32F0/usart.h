@@ -0,0 +1,63 @@
+/*******************************************************************************
+@file     usart.h
+@author   agent
+@date     18.10.2026
+@brief    DMA driven USART1 driver for STM32F0xx.
+          Enabled with USE_USART in DEFS.
+          TX: PA9, RX: PA10, DMA1 channel 2 (TX) and channel 3 (RX).
+*******************************************************************************/
+
+#pragma once
+
+#include <os.h>
+#include <stm32f0xx.h>
+
+/*******************************************************************************
+ Configuration
+*******************************************************************************/
+
+#ifndef   USART_RX_SIZE
+#define   USART_RX_SIZE    256    // <- size of the circular receive buffer, power of 2
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*******************************************************************************
+ Initialize USART1 and start the circular reception
+ baudrate: transmission speed in bits per second
+*******************************************************************************/
+
+void     usart_init( unsigned baudrate );
+
+/*******************************************************************************
+ Read received data; a single reader task is assumed
+ the task is woken once per frame (idle line) or once per half of the buffer
+ if the reader did not keep up and the buffer was overrun, the oldest data are
+ dropped and counted (usart_lost), the last half of the buffer is returned
+ return: number of bytes copied to 'data', 0 on timeout
+*******************************************************************************/
+
+unsigned usart_read( void *data, unsigned size, cnt_t delay );
+
+/*******************************************************************************
+ Number of received bytes lost in the overruns of the receive buffer
+ since usart_init; updated by usart_read
+*******************************************************************************/
+
+unsigned usart_lost( void );
+
+/*******************************************************************************
+ Transmit 'size' bytes directly from the caller's buffer by DMA (no copy)
+ the buffer must not be changed until the function returns
+ return: E_SUCCESS or E_TIMEOUT (the transfer is aborted)
+*******************************************************************************/
+
+unsigned usart_write( const void *data, unsigned size, cnt_t delay );
+
+#ifdef __cplusplus
+}
+#endif
+
+/******************************************************************************/
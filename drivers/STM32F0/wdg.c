@@ -0,0 +1,237 @@
+/*******************************************************************************
+@file     wdg.c
+@author   agent
+@date     18.10.2026
+@brief    Watchdog supervisor with per-task heartbeat deadlines for STM32F0xx.
+*******************************************************************************/
+
+#ifdef USE_WDG
+
+#include "wdg.h"
+#include "retain.h"
+#include <string.h>
+
+#if       WDG_TIMEOUT < 7 || WDG_TIMEOUT > 26000
+#error    Invalid WDG_TIMEOUT value!
+#endif
+#if       WDG_CHECK >= WDG_TIMEOUT
+#error    WDG_CHECK must be shorter than WDG_TIMEOUT!
+#endif
+
+/*******************************************************************************
+ IWDG: LSI (40kHz) / 256
+*******************************************************************************/
+
+#define   WDG_KEY_RELOAD  0xAAAAU
+#define   WDG_KEY_ACCESS  0x5555U
+#define   WDG_KEY_START   0xCCCCU
+#define   WDG_RELOAD     ((WDG_TIMEOUT * 40U + 255U) / 256U)
+
+#define   WDG_MAGIC       0x57444721U
+
+/*******************************************************************************
+ Supervisor state
+*******************************************************************************/
+
+static wdg_t    *wdg_queue; // heartbeats in the order of deadlines
+static wdg_rec_t wdg_last;  // record of the previous reset
+static bool      wdg_valid;
+
+static RETAIN_NOINIT struct
+{
+	uint32_t  magic;
+	wdg_rec_t rec;
+	uint32_t  check;
+
+}	wdg_keep;
+
+static void wdg_supervisor( void );
+
+static_TSK(wdg_task, WDG_PRIO, wdg_supervisor);
+
+/* -------------------------------------------------------------------------- */
+
+static
+uint32_t wdg_check( void )
+{
+	return retain_check(&wdg_keep.rec, sizeof(wdg_keep.rec), WDG_MAGIC);
+}
+
+/* -------------------------------------------------------------------------- */
+
+static
+bool wdg_expired( wdg_t *wdg, cnt_t now )
+{
+	return now - wdg->start > wdg->period;
+}
+
+/* -------------------------------------------------------------------------- */
+/* time left to the deadline, valid if not expired */
+
+static
+cnt_t wdg_left( wdg_t *wdg, cnt_t now )
+{
+	return wdg->start + wdg->period - now;
+}
+
+/* -------------------------------------------------------------------------- */
+/* called in a critical section */
+
+static
+void wdg_remove( wdg_t *wdg )
+{
+	wdg_t **ptr;
+
+	for (ptr = &wdg_queue; *ptr && *ptr != wdg; ptr = &(*ptr)->next);
+	if (*ptr)
+		*ptr = wdg->next;
+}
+
+/* -------------------------------------------------------------------------- */
+/* called in a critical section; the expired heartbeats stay at the beginning,
+   the new deadline is the latest among the equal */
+
+static
+void wdg_insert( wdg_t *wdg, cnt_t now )
+{
+	wdg_t **ptr;
+
+	wdg->start = now;
+	for (ptr = &wdg_queue; *ptr && (wdg_expired(*ptr, now) || wdg_left(*ptr, now) <= wdg->period); ptr = &(*ptr)->next);
+	wdg->next = *ptr;
+	*ptr = wdg;
+}
+
+/* -------------------------------------------------------------------------- */
+
+static __NO_RETURN
+void wdg_expire( wdg_t *wdg, cnt_t now )
+{
+	wdg_keep.rec.tsk    = wdg->owner;
+	wdg_keep.rec.wdg    = wdg;
+	wdg_keep.rec.period = wdg->period;
+	wdg_keep.rec.late   = now - wdg->start - wdg->period;
+	wdg_keep.rec.count  = wdg_valid ? wdg_last.count + 1 : 1;
+	wdg_keep.check      = wdg_check();
+	wdg_keep.magic      = WDG_MAGIC;
+
+	NVIC_SystemReset();
+}
+
+/* -------------------------------------------------------------------------- */
+
+static
+void wdg_supervisor( void )
+{
+	wdg_t *wdg;
+	cnt_t  now;
+
+	for (;;)
+	{
+		sys_lock();
+		{
+			now = sys_time();
+			wdg = wdg_queue;
+			/* the list is ordered by deadlines: only the first one is checked */
+			if (wdg != NULL && wdg_expired(wdg, now))
+				wdg_expire(wdg, now);
+		}
+		sys_unlock();
+
+		IWDG->KR = WDG_KEY_RELOAD;
+		tsk_delay(WDG_CHECK * MSEC);
+	}
+}
+
+/******************************************************************************/
+
+void wdg_init( void )
+{
+	/* the retained RAM is not valid after the power-on reset */
+	bool kept = (RCC->CSR & RCC_CSR_PORRSTF) == 0 &&
+	            wdg_keep.magic == WDG_MAGIC && wdg_keep.check == wdg_check();
+
+	if (kept && wdg_keep.rec.tsk != NULL)
+	{
+		/* reset by the supervisor: the record of the expired heartbeat */
+		wdg_last  = wdg_keep.rec;
+		wdg_valid = true;
+	}
+	else
+	if (RCC->CSR & RCC_CSR_IWDGRSTF)
+	{
+		/* reset by the IWDG: the supervisor stopped */
+		memset(&wdg_last, 0, sizeof(wdg_last));
+		wdg_last.count = (kept ? wdg_keep.rec.count : 0) + 1;
+		wdg_valid = true;
+	}
+
+	/* the number of consecutive watchdog resets is kept for the next IWDG reset */
+	memset(&wdg_keep.rec, 0, sizeof(wdg_keep.rec));
+	wdg_keep.rec.count = wdg_valid ? wdg_last.count : 0;
+	wdg_keep.check     = wdg_check();
+	wdg_keep.magic     = WDG_MAGIC;
+	RCC->CSR |= RCC_CSR_RMVF;
+
+	DBGMCU->APB1FZ |= DBGMCU_APB1_FZ_DBG_IWDG_STOP;
+
+	IWDG->KR  = WDG_KEY_START;
+	IWDG->KR  = WDG_KEY_ACCESS;
+	IWDG->PR  = IWDG_PR_PR_2 | IWDG_PR_PR_1; // LSI / 256
+	IWDG->RLR = WDG_RELOAD;
+	while (IWDG->SR & (IWDG_SR_PVU | IWDG_SR_RVU));
+	IWDG->KR  = WDG_KEY_RELOAD;
+
+	tsk_start(wdg_task);
+}
+
+/******************************************************************************/
+
+const wdg_rec_t *wdg_record( void )
+{
+	return wdg_valid ? &wdg_last : NULL;
+}
+
+/******************************************************************************/
+
+void wdg_register( wdg_t *wdg, cnt_t period )
+{
+	sys_lock();
+	{
+		wdg_remove(wdg);
+		wdg->owner  = tsk_this();
+		wdg->period = period;
+		wdg_insert(wdg, sys_time());
+	}
+	sys_unlock();
+}
+
+/******************************************************************************/
+
+void wdg_unregister( wdg_t *wdg )
+{
+	sys_lock();
+	{
+		wdg_remove(wdg);
+		wdg->owner = NULL;
+	}
+	sys_unlock();
+}
+
+/******************************************************************************/
+
+void wdg_beat( wdg_t *wdg )
+{
+	sys_lock();
+	/* an unregistered heartbeat is ignored */
+	if (wdg->owner != NULL)
+	{
+		wdg_remove(wdg);
+		wdg_insert(wdg, sys_time());
+	}
+	sys_unlock();
+}
+
+/******************************************************************************/
+
+#endif//USE_WDG
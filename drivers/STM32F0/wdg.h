@@ -0,0 +1,117 @@
+/*******************************************************************************
+@file     wdg.h
+@author   agent
+@date     18.10.2026
+@brief    Watchdog supervisor with per-task heartbeat deadlines for STM32F0xx.
+          Enabled with USE_WDG in DEFS.
+          Every monitored task registers a heartbeat with its deadline and
+          beats before the deadline expires. The heartbeats are kept in the
+          order of their deadlines, so the supervisor task checks only the
+          first one (O(1) every WDG_CHECK ms) and refreshes the IWDG only
+          while no deadline has expired; a heartbeat is moved to its new
+          place in the list (linear in the number of heartbeats).
+          On expiry the offending task is recorded in retained RAM and the
+          system is reset at once; if the supervisor itself stops (interrupt
+          storm, a higher priority task running away), the IWDG resets the
+          system after WDG_TIMEOUT ms.
+          The retained RAM (.noinit) must be reserved in the linker scripts.
+*******************************************************************************/
+
+#pragma once
+
+#include <os.h>
+#include <stm32f0xx.h>
+
+/*******************************************************************************
+ Configuration
+*******************************************************************************/
+
+#ifndef   WDG_TIMEOUT
+#define   WDG_TIMEOUT       1000  // <- IWDG timeout in milliseconds (7..26000)
+#endif
+#ifndef   WDG_CHECK
+#define   WDG_CHECK          100  // <- period of the supervisor in milliseconds
+#endif
+#ifndef   WDG_PRIO
+#define   WDG_PRIO            15  // <- priority of the supervisor task, above the monitored tasks
+#endif
+
+/*******************************************************************************
+ Heartbeat of the monitored task
+*******************************************************************************/
+
+typedef struct __wdg
+{
+	struct __wdg *next;    // next heartbeat in the order of deadlines
+	tsk_t        *owner;
+	cnt_t         start;   // time of the last beat
+	cnt_t         period;  // deadline of the heartbeat
+
+}	wdg_t;
+
+#define  _WDG_INIT() \
+	{ NULL, NULL, 0, 0 }
+
+#define   OS_WDG(wdg) \
+	wdg_t wdg[1] = { _WDG_INIT() }
+
+#define   static_WDG(wdg) \
+	static wdg_t wdg[1] = { _WDG_INIT() }
+
+/*******************************************************************************
+ Reset record, kept in retained RAM over the reset
+*******************************************************************************/
+
+typedef struct __wdg_rec
+{
+	tsk_t    *tsk;     // the offending task, NULL: the IWDG reset the system
+	wdg_t    *wdg;     // its heartbeat
+	cnt_t     period;  // deadline of the heartbeat
+	cnt_t     late;    // time elapsed after the deadline when detected
+	unsigned  count;   // number of consecutive watchdog resets (supervisor and IWDG)
+
+}	wdg_rec_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*******************************************************************************
+ Take over the reset record, start the IWDG and the supervisor task;
+ call once at the beginning of the application (clears the reset flags of RCC)
+*******************************************************************************/
+
+void      wdg_init( void );
+
+/*******************************************************************************
+ Record of the previous reset, if caused by the watchdog
+ return: pointer to the record, NULL if the previous reset had other cause
+*******************************************************************************/
+
+const
+wdg_rec_t*wdg_record( void );
+
+/*******************************************************************************
+ Monitor the calling task: it must call wdg_beat at least every 'period'
+*******************************************************************************/
+
+void      wdg_register( wdg_t *wdg, cnt_t period );
+
+/*******************************************************************************
+ Stop monitoring the heartbeat (e.g. before a long blocking operation)
+*******************************************************************************/
+
+void      wdg_unregister( wdg_t *wdg );
+
+/*******************************************************************************
+ Heartbeat: the next deadline is 'period' from now;
+ ignored if the heartbeat is not registered
+*******************************************************************************/
+
+void      wdg_beat( wdg_t *wdg );
+
+#ifdef __cplusplus
+}
+#endif
+
+/******************************************************************************/
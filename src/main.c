@@ -1,7 +1,22 @@
 #include <os.h>
+#ifdef USE_PGO
+#include "pgo.h"
+#endif
+#ifdef USE_BENCH
+#include "bench.h"
+#endif
 
 int main()
 {
+#ifdef USE_BENCH
+	bench_run();
+#endif
+#ifdef USE_PGO
+#ifndef USE_BENCH
+	tsk_delay(PGO_TIME * SEC);
+#endif
+	pgo_exit();
+#endif
 	for (;;)
 	{
 		tsk_delay(SEC);
@@ -0,0 +1,113 @@
+/*******************************************************************************
+@file     oscore.h
+@author   agent
+@date     18.10.2026
+@brief    StateOS port core definitions for the linux host simulator.
+*******************************************************************************/
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+/*******************************************************************************
+ Compiler definitions normally provided by CMSIS
+*******************************************************************************/
+
+#ifndef __STATIC_INLINE
+#define __STATIC_INLINE       static inline
+#endif
+#ifndef __STATIC_FORCEINLINE
+#define __STATIC_FORCEINLINE  __attribute__((always_inline)) static inline
+#endif
+#ifndef __NO_RETURN
+#define __NO_RETURN           __attribute__((__noreturn__))
+#endif
+#ifndef __WEAK
+#define __WEAK                __attribute__((weak))
+#endif
+#ifndef __USED
+#define __USED                __attribute__((used))
+#endif
+#ifndef __ALIGNED
+#define __ALIGNED(x)          __attribute__((aligned(x)))
+#endif
+#ifndef __CONSTRUCTOR
+#define __CONSTRUCTOR         __attribute__((constructor))
+#endif
+
+#define __NOP()               __asm volatile ("nop")
+#define __WFI()               port_idle_hook()
+
+/*******************************************************************************
+ CMSIS core intrinsics for the drivers built on the host;
+ the header of the target compiler (cmsis_gcc.h) is not used
+*******************************************************************************/
+
+#define __CMSIS_GCC_H
+
+#ifndef __ASM
+#define __ASM                 __asm
+#endif
+#ifndef __INLINE
+#define __INLINE              inline
+#endif
+#ifndef __PACKED
+#define __PACKED              __attribute__((packed, aligned(1)))
+#endif
+#ifndef __COMPILER_BARRIER
+#define __COMPILER_BARRIER()  __atomic_signal_fence(__ATOMIC_SEQ_CST)
+#endif
+
+#define __DMB()               __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#define __DSB()               __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#define __ISB()               __atomic_signal_fence(__ATOMIC_SEQ_CST)
+#define __enable_irq()        port_clr_lock()
+#define __disable_irq()       port_set_lock()
+#define __get_PRIMASK()       port_get_lock()
+#define __set_PRIMASK(lck)    port_put_lock(lck)
+#define __get_IPSR()          (host_isr ? 15U : 0U) // SysTick
+
+/*******************************************************************************
+ Host stack of every simulated task in bytes
+ the kernel stack of the task keeps only the context descriptor
+*******************************************************************************/
+
+#ifndef HOST_STACK_SIZE
+#define HOST_STACK_SIZE   65536
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*******************************************************************************
+ Task context
+*******************************************************************************/
+
+typedef void fun_t( void );
+
+typedef uint64_t stk_t;
+
+typedef struct __ctx ctx_t;
+
+struct __ctx
+{
+	void   * uc;  // host context, allocated at the first activation of the task
+	fun_t  * pc;  // task entry
+};
+
+#define _CTX_INIT( pc ) { 0, pc }
+
+__STATIC_INLINE
+void port_ctx_init( ctx_t *ctx, fun_t *pc )
+{
+	ctx->uc = 0;
+	ctx->pc = pc;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+/******************************************************************************/
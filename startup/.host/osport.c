@@ -0,0 +1,274 @@
+/*******************************************************************************
+@file     osport.c
+@author   agent
+@date     18.10.2026
+@brief    StateOS port file for the linux host simulator.
+*******************************************************************************/
+
+#include <os.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <ucontext.h>
+#include <sys/mman.h>
+#include <sys/time.h>
+
+/*******************************************************************************
+ Number of host stacks available for the simulated tasks
+*******************************************************************************/
+
+#ifndef HOST_TASKS
+#define HOST_TASKS           32
+#endif
+
+/*******************************************************************************
+ Simulated address space of the flash memory (erased),
+ of the peripherals (APB, AHB1, AHB2) and of the system control space
+*******************************************************************************/
+
+#define HOST_FLASH_BASE      0x08000000U
+#define HOST_FLASH_SIZE      0x00040000U
+#define HOST_PERIPH_BASE     0x40000000U
+#define HOST_PERIPH_SIZE     0x08002000U
+#define HOST_SCS_BASE        0xE000E000U
+#define HOST_SCS_SIZE        0x00001000U
+
+/*******************************************************************************
+ Kernel entry points used by the port
+*******************************************************************************/
+
+void *core_tsk_handler( void *sp );
+void  core_sys_tick( void );
+
+/*******************************************************************************
+ Simulated cpu state
+*******************************************************************************/
+
+volatile lck_t    host_lock = 0;
+volatile unsigned host_isr  = 0;
+
+uint32_t SystemCoreClock = CPU_FREQUENCY; // system_stm32f0xx.c is not built
+
+static volatile unsigned host_ticks = 0;
+static volatile unsigned host_pend  = 0;
+
+typedef struct
+{
+	ctx_t     * owner;
+	ucontext_t  uc;
+	stk_t       stack[HOST_STACK_SIZE / sizeof(stk_t)];
+
+}	host_t;
+
+static host_t      host_slot[HOST_TASKS];
+static host_t    * host_run = 0;               // slot of the running task, 0: main task
+static ucontext_t  host_main;
+static ucontext_t  host_dead;
+static ctx_t       host_ctx = { &host_main, 0 }; // context of the main task
+static ctx_t     * host_cur = &host_ctx;
+
+/* -------------------------------------------------------------------------- */
+
+static
+void host_entry( void )
+{
+	fun_t *pc = host_cur->pc;
+
+	/* the new task starts with the lock held by host_switch */
+	host_lock = 0;
+	port_sys_pend();
+	pc();
+	abort();
+}
+
+/* -------------------------------------------------------------------------- */
+/* a slot is free when its task was restarted (port_ctx_init cleared the context)
+   or the task object was reused for another task; the running slot is never
+   reused, since the task may be restarting itself */
+
+static
+bool host_unused( host_t *h )
+{
+	return h->owner == 0 || (h != host_run && h->owner->uc != &h->uc);
+}
+
+/* -------------------------------------------------------------------------- */
+
+static
+host_t *host_context( ctx_t *ctx )
+{
+	host_t *slot = 0;
+	host_t *h;
+
+	for (h = host_slot; h < host_slot + HOST_TASKS; h++)
+	{
+		if (h->owner == ctx && h != host_run) { slot = h; break; }
+		if (slot == 0 && host_unused(h)) slot = h;
+	}
+
+	if (slot == 0)
+	{
+		fputs("host: no free task slot, increase HOST_TASKS\n", stderr);
+		abort();
+	}
+
+	slot->owner = ctx;
+	getcontext(&slot->uc);
+	slot->uc.uc_stack.ss_sp   = slot->stack;
+	slot->uc.uc_stack.ss_size = sizeof(slot->stack);
+	slot->uc.uc_link          = 0;
+	sigemptyset(&slot->uc.uc_sigmask);
+	makecontext(&slot->uc, host_entry, 0);
+
+	ctx->uc = &slot->uc;
+
+	return slot;
+}
+
+/* -------------------------------------------------------------------------- */
+
+static
+void host_switch( void )
+{
+	ctx_t  *prev = host_cur;
+	ctx_t  *next = core_tsk_handler(prev);
+
+	if (next == prev)
+		return;
+
+	if (next->uc == 0)
+		host_run = host_context(next);
+	else
+	if (next->uc == &host_main)
+		host_run = 0;
+	else
+		host_run = (host_t *)((char *) next->uc - offsetof(host_t, uc));
+
+	host_cur = next;
+	/* the context of a task restarted by itself is no longer needed */
+	swapcontext(prev->uc ? prev->uc : &host_dead, next->uc);
+}
+
+/* -------------------------------------------------------------------------- */
+/* the signal handler only counts the tick; the tick and the context switch are
+   processed outside of the handler, where the lock is released (port_put_lock)
+   and in the idle task: a task that runs without calling the kernel is not
+   preempted on the host */
+
+static
+void host_tick( int signum )
+{
+	(void) signum;
+
+	__atomic_add_fetch(&host_ticks, 1, __ATOMIC_SEQ_CST);
+}
+
+/* -------------------------------------------------------------------------- */
+/* memory in place of the flash, the peripheral registers and the system
+   control space, so the drivers can run on the host; the tests act as the
+   hardware */
+
+static
+void host_periph( uintptr_t base, size_t size )
+{
+	void *ptr = mmap((void *) base, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE | MAP_NORESERVE, -1, 0);
+
+	if (ptr != (void *) base)
+	{
+		fputs("host: the peripheral address space is not available\n", stderr);
+		abort();
+	}
+}
+
+/*******************************************************************************
+ Port interface
+*******************************************************************************/
+
+void port_sys_init( void )
+{
+#ifndef HOST_VIRTUAL
+	struct sigaction sa = { 0 };
+	struct itimerval it = { 0 };
+	long period = 1000000L / OS_FREQUENCY / HOST_SPEED;
+#endif
+
+	host_periph(HOST_FLASH_BASE,  HOST_FLASH_SIZE);
+	memset((void *) HOST_FLASH_BASE, 0xFF, HOST_FLASH_SIZE);
+	host_periph(HOST_PERIPH_BASE, HOST_PERIPH_SIZE);
+	host_periph(HOST_SCS_BASE,    HOST_SCS_SIZE);
+
+#ifndef HOST_VIRTUAL
+	sa.sa_handler = host_tick;
+	sa.sa_flags   = SA_RESTART;
+	sigemptyset(&sa.sa_mask);
+	sigaction(SIGALRM, &sa, 0);
+
+	if (period < 1) period = 1;
+	it.it_interval.tv_sec  = period / 1000000L;
+	it.it_interval.tv_usec = period % 1000000L;
+	it.it_value            = it.it_interval;
+	setitimer(ITIMER_REAL, &it, 0);
+#endif
+}
+
+/* -------------------------------------------------------------------------- */
+
+void port_sys_pend( void )
+{
+	while (host_lock == 0 && (host_ticks != 0 || host_pend != 0))
+	{
+		host_lock = 1;
+
+		while (host_ticks != 0)
+		{
+			__atomic_sub_fetch(&host_ticks, 1, __ATOMIC_SEQ_CST);
+			host_isr = 1;
+			core_sys_tick();
+			host_isr = 0;
+		}
+
+		if (host_pend != 0)
+		{
+			host_pend = 0;
+			host_switch();
+		}
+
+		host_lock = 0;
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+void port_ctx_pend( void )
+{
+	host_pend = 1;
+	if (host_lock == 0)
+		port_sys_pend();
+}
+
+/* -------------------------------------------------------------------------- */
+
+void port_idle_hook( void )
+{
+#ifndef HOST_VIRTUAL
+	sigset_t set, old;
+
+	/* the tick can not be missed between the test and the wait */
+	sigemptyset(&set);
+	sigaddset(&set, SIGALRM);
+	sigprocmask(SIG_BLOCK, &set, &old);
+	if (host_ticks == 0)
+	{
+		sigdelset(&old, SIGALRM);
+		sigsuspend(&old);
+	}
+	sigprocmask(SIG_UNBLOCK, &set, 0);
+#else
+	host_tick(SIGALRM);
+#endif
+	port_sys_pend();
+}
+
+/******************************************************************************/
@@ -0,0 +1,142 @@
+/*******************************************************************************
+@file     osport.h
+@author   agent
+@date     18.10.2026
+@brief    StateOS port definitions for the linux host simulator.
+          Tasks run on ucontext stacks, SysTick is emulated by SIGALRM,
+          interrupt masking by a software lock (see osport.c).
+          The signal handler only counts the ticks; the ticks and the context
+          switches are processed when the lock is released (every kernel call)
+          and in the idle task, never inside the handler: a task that runs
+          without calling the kernel is not preempted on the host.
+          The flash, the peripheral registers and the system control space
+          are plain memory mapped at their addresses, so the drivers can be
+          linked and driven by the tests, which play the part of the hardware
+          (make -f makefile.host test, see tests/). The host image is linked
+          at a fixed address below 4GB, so the addresses of the static data
+          fit in the 32-bit DMA registers.
+*******************************************************************************/
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <osconfig.h>
+#include <oscore.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*******************************************************************************
+ Simulation speed
+ HOST_SPEED == 1 => system tick follows the wall-clock time
+ HOST_SPEED >  1 => system tick runs HOST_SPEED times faster than real time
+*******************************************************************************/
+
+#ifndef HOST_SPEED
+#define HOST_SPEED            1
+#endif
+
+/*******************************************************************************
+ Virtual time (HOST_VIRTUAL defined)
+ the system tick is not driven by the host timer; it advances by one tick each
+ time the idle task runs, so the simulated time does not depend on the host
+ speed and the run is reproducible; HOST_SPEED is ignored
+ a task that never blocks does not consume any virtual time
+*******************************************************************************/
+
+/*******************************************************************************
+ Port configuration
+*******************************************************************************/
+
+#define OS_TICKLESS           0 // the host port works in tick mode only
+
+#define HW_TIMER_SIZE         0
+
+#if OS_TIMER_SIZE != 32 && OS_TIMER_SIZE != 64
+#error  osconfig.h: Invalid OS_TIMER_SIZE value!
+#endif
+
+/*******************************************************************************
+ Simulated cpu state
+*******************************************************************************/
+
+typedef unsigned lck_t;
+
+extern volatile lck_t    host_lock;  // 'interrupts' disabled
+extern volatile unsigned host_isr;   // inside the simulated tick interrupt
+
+void port_sys_init( void );
+void port_sys_pend( void );          // process pending tick and context switch
+void port_ctx_pend( void );          // request a context switch (PendSV)
+void port_idle_hook( void );
+
+/*******************************************************************************
+ Critical sections
+*******************************************************************************/
+
+__STATIC_INLINE
+lck_t port_get_lock( void )
+{
+	return host_lock;
+}
+
+__STATIC_INLINE
+void port_put_lock( lck_t lck )
+{
+	host_lock = lck;
+	if (lck == 0) port_sys_pend();
+}
+
+__STATIC_INLINE
+void port_set_lock( void )
+{
+	host_lock = 1;
+}
+
+__STATIC_INLINE
+void port_clr_lock( void )
+{
+	port_put_lock(0);
+}
+
+__STATIC_INLINE
+void port_set_barrier( void )
+{
+	__atomic_signal_fence(__ATOMIC_SEQ_CST);
+}
+
+/*******************************************************************************
+ Context switch
+*******************************************************************************/
+
+__STATIC_INLINE
+void port_ctx_switch( void )
+{
+	port_ctx_pend();
+}
+
+__STATIC_INLINE
+void port_ctx_switchNow( void )
+{
+	port_ctx_pend();
+	port_sys_pend();
+}
+
+__STATIC_INLINE
+void port_ctx_reset( void )
+{
+}
+
+__STATIC_INLINE
+bool port_isr_context( void )
+{
+	return host_isr != 0;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+/******************************************************************************/
@@ -61,8 +61,9 @@ __initial_sp    EQU     __initial_msp
  Prototypes of external functions
 *******************************************************************************/
 
-__NO_RETURN __ALIAS(Fault_Handler) void _microlib_exit( void );
-__NO_RETURN __ALIAS(Fault_Handler) void      _sys_exit( void );
+/* the end of the program (exit) with its status, as _exit of the GNU library */
+__NO_RETURN __ALIAS(_exit)         void _microlib_exit( int status );
+__NO_RETURN __ALIAS(_exit)         void      _sys_exit( int status );
 __NO_RETURN                        void         __main( void );
 
 /******************************************************************************/
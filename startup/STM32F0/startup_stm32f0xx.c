@@ -14,7 +14,20 @@
 *******************************************************************************/
 
 #define   RAM_start 0x20000000
+
+#if   defined(STM32F030x6) || defined(STM32F031x6) || defined(STM32F038xx)
+#define   RAM_end   0x20001000
+#elif defined(STM32F042x6) || defined(STM32F048xx) || defined(STM32F070x6)
+#define   RAM_end   0x20001800
+#elif defined(STM32F030x8) || defined(STM32F051x8) || defined(STM32F058xx)
 #define   RAM_end   0x20002000
+#elif defined(STM32F070xB) || defined(STM32F071xB) || defined(STM32F072xB) || defined(STM32F078xx)
+#define   RAM_end   0x20004000
+#elif defined(STM32F030xC) || defined(STM32F091xC) || defined(STM32F098xx)
+#define   RAM_end   0x20008000
+#else
+#error    Unknown chip!
+#endif
 
 /*******************************************************************************
  Configuration of stacks
@@ -34,6 +47,14 @@
 extern char __initial_msp[];
 extern char __initial_sp [];
 
+/*******************************************************************************
+ Fault capture and warm restart (fault.h)
+*******************************************************************************/
+
+#ifdef USE_FAULT
+__NO_RETURN void fault_save( const uint32_t *frame, int status );
+#endif
+
 /*******************************************************************************
  Default _exit handler
 *******************************************************************************/
@@ -41,9 +62,16 @@ extern char __initial_sp [];
 __WEAK __NO_RETURN
 void _exit( int status )
 {
+#ifdef USE_FAULT
+	/* Record an abnormal exit and restart the system */
+	if (status != 0)
+		fault_save(0, status);
+	NVIC_SystemReset();
+#else
 	(void) status;
 	/* Go into an infinite loop */
 	for (;;);
+#endif
 }
 
 /*******************************************************************************
@@ -53,8 +81,13 @@ void _exit( int status )
 __NO_RETURN
 void Fault_Handler( void )
 {
+#ifdef USE_FAULT
+	/* Record the exception and restart the system */
+	fault_save(0, 0);
+#else
 	/* Go into an infinite loop */
 	for (;;);
+#endif
 }
 
 /*******************************************************************************
@@ -0,0 +1,112 @@
+/*******************************************************************************
+@file     fastmem.c
+@author   agent
+@date     19.10.2026
+@brief    memcpy, memmove and memset test: random sizes, alignments and
+          overlaps checked against byte loops; the bytes around the
+          destination must stay untouched.
+*******************************************************************************/
+
+#ifdef HOST_TEST
+
+#include "test.h"
+
+#define   MEM_RUNS  100000 // <- number of random operations
+#define   MEM_MAX   300    // <- largest block
+#define   MEM_PAD   16     // <- guard bytes on both sides of the blocks
+
+static uint8_t  mem_buf[MEM_PAD + MEM_MAX * 2 + MEM_PAD];
+static uint8_t  mem_ref[MEM_PAD + MEM_MAX * 2 + MEM_PAD];
+static uint8_t  mem_src[MEM_MAX + 8];
+static uint32_t mem_seed = 2463534242U;
+
+/* -------------------------------------------------------------------------- */
+
+static uint32_t mem_rand( void )
+{
+	mem_seed ^= mem_seed << 13;
+	mem_seed ^= mem_seed >> 17;
+	mem_seed ^= mem_seed << 5;
+	return mem_seed;
+}
+
+/* -------------------------------------------------------------------------- */
+
+static void mem_fill( uint8_t *buf, size_t size )
+{
+	while (size--) *buf++ = (uint8_t) mem_rand();
+}
+
+/* -------------------------------------------------------------------------- */
+/* the function under test and the reference got the same operation */
+
+static void mem_check( unsigned op, size_t dst, size_t src, size_t size )
+{
+	bool same = memcmp(mem_buf, mem_ref, sizeof(mem_buf)) == 0;
+
+	if (!same)
+		printf("op %u dst %u src %u size %u\n", op, (unsigned) dst, (unsigned) src, (unsigned) size);
+
+	TEST_CHECK(same);
+}
+
+/******************************************************************************/
+
+int main()
+{
+	unsigned i, op;
+	size_t   dst, src, size, n;
+	uint8_t  c;
+
+	for (i = 0; i < MEM_RUNS; i++)
+	{
+		mem_fill(mem_buf, sizeof(mem_buf));
+		for (n = 0; n < sizeof(mem_buf); n++) mem_ref[n] = mem_buf[n];
+		mem_fill(mem_src, sizeof(mem_src));
+
+		op   = mem_rand() % 4;
+		size = i < MEM_MAX ? i : mem_rand() % (MEM_MAX + 1);
+		dst  = MEM_PAD + mem_rand() % (MEM_MAX + 1);
+		src  = mem_rand() % 8;
+
+		switch (op)
+		{
+		case 0: /* separate buffers */
+			memcpy(mem_buf + dst, mem_src + src, size);
+			for (n = 0; n < size; n++) mem_ref[dst + n] = mem_src[src + n];
+			break;
+
+		case 1: /* overlapping, both directions */
+			src = MEM_PAD + mem_rand() % (MEM_MAX + 1);
+			memmove(mem_buf + dst, mem_buf + src, size);
+			if (dst < src)
+				for (n = 0; n < size; n++) mem_ref[dst + n] = mem_ref[src + n];
+			else
+				for (n = size; n > 0; n--) mem_ref[dst + n - 1] = mem_ref[src + n - 1];
+			break;
+
+		case 2: /* close overlaps, the hardest alignments */
+			src = dst + (mem_rand() % 9) - 4;
+			memmove(mem_buf + dst, mem_buf + src, size);
+			if (dst < src)
+				for (n = 0; n < size; n++) mem_ref[dst + n] = mem_ref[src + n];
+			else
+				for (n = size; n > 0; n--) mem_ref[dst + n - 1] = mem_ref[src + n - 1];
+			break;
+
+		default:
+			c = (uint8_t) mem_rand();
+			memset(mem_buf + dst, c, size);
+			for (n = 0; n < size; n++) mem_ref[dst + n] = c;
+			break;
+		}
+
+		mem_check(op, dst, src, size);
+	}
+
+	TEST_PASS();
+}
+
+/******************************************************************************/
+
+#endif//HOST_TEST
@@ -0,0 +1,59 @@
+/*******************************************************************************
+@file     port.c
+@author   agent
+@date     19.10.2026
+@brief    Host port test: the tick, the task slots and the peripheral memory.
+*******************************************************************************/
+
+#ifdef HOST_TEST
+
+#include "test.h"
+
+#define   PORT_RUNS  100 // <- more than HOST_TASKS: the slots must be reused
+
+static_SEM(port_done, 0, semCounting);
+
+static unsigned port_count = 0;
+
+/* -------------------------------------------------------------------------- */
+
+static void port_worker( void )
+{
+	port_count++;
+	sem_give(port_done);
+}
+
+static_TSK(port_task, OS_MAIN_PRIO + 1, port_worker);
+
+/******************************************************************************/
+
+int main()
+{
+	cnt_t    start;
+	unsigned i;
+
+	/* the tick */
+	start = sys_time();
+	tsk_delay(SEC);
+	TEST_CHECK(sys_time() - start == SEC);
+
+	/* a task started and stopped again and again */
+	for (i = 0; i < PORT_RUNS; i++)
+	{
+		tsk_start(port_task);
+		TEST_CHECK(sem_waitFor(port_done, SEC) == E_SUCCESS);
+		tsk_delay(1);
+	}
+	TEST_CHECK(port_count == PORT_RUNS);
+
+	/* the peripheral registers */
+	RCC->AHBENR |= RCC_AHBENR_CRCEN;
+	TEST_CHECK(RCC->AHBENR & RCC_AHBENR_CRCEN);
+	TEST_CHECK(*(volatile uint32_t *) FLASH_BASE == 0xFFFFFFFFU);
+
+	TEST_PASS();
+}
+
+/******************************************************************************/
+
+#endif//HOST_TEST
@@ -0,0 +1,205 @@
+/*******************************************************************************
+@file     ring.c
+@author   agent
+@date     19.10.2026
+@brief    SPSC ring buffer test: the barriers, with the producer on a host
+          thread running in parallel with the consumer, and the wait flag,
+          with a producer task waking the blocked consumer.
+          The stream is a known byte sequence, read and written in chunks
+          of random sizes; a lost, repeated or stale byte fails the test.
+*******************************************************************************/
+
+#ifdef HOST_TEST
+
+#include "test.h"
+#include "ring.h"
+#include <pthread.h>
+#include <sched.h>
+
+#define   RING_SIZE      64      // <- size of the ring, a power of 2
+#define   RING_BYTES     4000000 // <- bytes passed between the threads
+#define   RING_TASK      20000   // <- bytes passed between the tasks
+#define   RING_CHUNK     24      // <- largest chunk, below RING_SIZE
+
+static_RING(ring_test, RING_SIZE);
+
+/* -------------------------------------------------------------------------- */
+
+static uint8_t ring_byte( unsigned pos )
+{
+	return (uint8_t)(pos % 251);
+}
+
+/* -------------------------------------------------------------------------- */
+/* xorshift; each side has its own state */
+
+static unsigned ring_rand( uint32_t *seed )
+{
+	*seed ^= *seed << 13;
+	*seed ^= *seed >> 17;
+	*seed ^= *seed << 5;
+	return *seed;
+}
+
+/* -------------------------------------------------------------------------- */
+/* the chunk received from the ring must continue the sequence */
+
+static void ring_verify( const uint8_t *buf, unsigned pos, unsigned size )
+{
+	unsigned n;
+
+	for (n = 0; n < size; n++)
+		if (buf[n] != ring_byte(pos + n))
+		{
+			printf("byte %u: %u instead of %u\n", pos + n, buf[n], ring_byte(pos + n));
+			TEST_CHECK(buf[n] == ring_byte(pos + n));
+		}
+}
+
+/* -------------------------------------------------------------------------- */
+/* producer: whole records (ring_put) and as many bytes as fit (ring_write),
+   never beyond the end of the stream */
+
+static unsigned ring_produce( unsigned pos, unsigned end, uint32_t *seed )
+{
+	uint8_t  buf[RING_CHUNK];
+	unsigned size = 1 + ring_rand(seed) % RING_CHUNK;
+	unsigned n;
+
+	if (size > end - pos)
+		size = end - pos;
+
+	for (n = 0; n < size; n++)
+		buf[n] = ring_byte(pos + n);
+
+	if (ring_rand(seed) & 1)
+		return ring_put(ring_test, buf, size) ? size : 0;
+
+	return ring_write(ring_test, buf, size);
+}
+
+/* -------------------------------------------------------------------------- */
+/* consumer: up to 'size' bytes (ring_read) or the whole record (ring_get),
+   never beyond the end of the stream */
+
+static unsigned ring_consume( unsigned pos, unsigned end, uint32_t *seed, cnt_t delay )
+{
+	uint8_t  buf[RING_CHUNK];
+	unsigned size = 1 + ring_rand(seed) % RING_CHUNK;
+
+	if (size > end - pos)
+		size = end - pos;
+
+	if (ring_rand(seed) & 1)
+		size = ring_get(ring_test, buf, size, delay) ? size : 0;
+	else
+		size = ring_read(ring_test, buf, size, delay);
+
+	ring_verify(buf, pos, size);
+
+	return size;
+}
+
+/*******************************************************************************
+ Barriers: the producer is a host thread, the consumer never waits (IMMEDIATE),
+ so neither side calls the kernel
+*******************************************************************************/
+
+static void *ring_producer_thread( void *arg )
+{
+	uint32_t seed = 2463534242U;
+	unsigned pos  = 0;
+	unsigned size;
+
+	(void) arg;
+
+	while (pos < RING_BYTES)
+	{
+		size = ring_produce(pos, RING_BYTES, &seed);
+		if (size == 0)
+			sched_yield();
+		pos += size;
+	}
+
+	return NULL;
+}
+
+static void ring_threads( void )
+{
+	pthread_t thread;
+	uint32_t  seed = 88675123U;
+	unsigned  pos  = 0;
+	unsigned  size;
+
+	ring_init(ring_test, ring_test__buf, RING_SIZE);
+	TEST_CHECK(pthread_create(&thread, NULL, ring_producer_thread, NULL) == 0);
+
+	while (pos < RING_BYTES)
+	{
+		size = ring_consume(pos, RING_BYTES, &seed, IMMEDIATE);
+		if (size == 0)
+			sched_yield();
+		pos += size;
+	}
+
+	TEST_CHECK(pthread_join(thread, NULL) == 0);
+	TEST_CHECK(ring_count(ring_test) == 0);
+}
+
+/*******************************************************************************
+ Wait flag: the producer task sleeps between the chunks, the consumer blocks
+ on the ring; a lost wakeup is reported as the timeout of the consumer
+*******************************************************************************/
+
+static void ring_producer_task( void )
+{
+	uint32_t seed = 2463534242U;
+	unsigned pos  = 0;
+	unsigned size;
+
+	while (pos < RING_TASK)
+	{
+		tsk_delay(1 + ring_rand(&seed) % 2); // the consumer runs out of data and waits
+		size = ring_produce(pos, RING_TASK, &seed);
+		pos += size;
+	}
+
+	tsk_stop();
+}
+
+static_TSK(ring_task, OS_MAIN_PRIO + 1, ring_producer_task);
+
+static void ring_tasks( void )
+{
+	uint32_t seed = 88675123U;
+	unsigned pos  = 0;
+	unsigned size;
+
+	ring_init(ring_test, ring_test__buf, RING_SIZE);
+	tsk_start(ring_task);
+
+	while (pos < RING_TASK)
+	{
+		size = ring_consume(pos, RING_TASK, &seed, SEC);
+		if (size == 0)
+			printf("consumer timed out at byte %u, %u bytes in the ring\n", pos, ring_count(ring_test));
+		TEST_CHECK(size > 0);
+		pos += size;
+	}
+
+	TEST_CHECK(ring_count(ring_test) == 0);
+}
+
+/******************************************************************************/
+
+int main()
+{
+	ring_threads();
+	ring_tasks();
+
+	TEST_PASS();
+}
+
+/******************************************************************************/
+
+#endif//HOST_TEST
@@ -0,0 +1,33 @@
+/*******************************************************************************
+@file     test.h
+@author   agent
+@date     19.10.2026
+@brief    Checks of the host tests (make -f makefile.host test).
+          Every tests/<name>.c is linked with the modules of DEFS_TEST_<name>
+          in place of src/main.c, runs in virtual time and exits with 0 when
+          all the checks passed.
+*******************************************************************************/
+
+#pragma once
+
+#include <os.h>
+#include <stm32f0xx.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*******************************************************************************
+ Stop the test with the failure status if the condition is false
+*******************************************************************************/
+
+#define   TEST_CHECK(cond) \
+	do { if (!(cond)) { printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); exit(1); } } while (0)
+
+/*******************************************************************************
+ End of the test
+*******************************************************************************/
+
+#define   TEST_PASS() \
+	do { printf("%s: passed\n", __FILE__); exit(0); } while (0)
+
+/******************************************************************************/
@@ -0,0 +1,183 @@
+/*******************************************************************************
+@file     timeconv.c
+@author   agent
+@date     19.10.2026
+@brief    Conversion test: every helper of utils/timeconv.h against the exact
+          division, on the edges and on random values of every length.
+          The frequency and the timer size of osconfig.h can be replaced with
+          TEST_FREQUENCY and TEST_TIMER_SIZE (tests/timeconv_*.c).
+*******************************************************************************/
+
+#ifdef HOST_TEST
+
+#include "test.h"
+
+#ifdef    TEST_FREQUENCY
+#undef    OS_FREQUENCY
+#define   OS_FREQUENCY   TEST_FREQUENCY
+#endif
+#ifdef    TEST_TIMER_SIZE
+#undef    OS_TIMER_SIZE
+#define   OS_TIMER_SIZE  TEST_TIMER_SIZE
+#endif
+
+#include "timeconv.h"
+
+#define   CNV_RUNS  1000000 // <- number of random values of each test
+
+#if OS_TIMER_SIZE == 64
+typedef uint64_t tim_t;
+#else
+typedef uint32_t tim_t;
+#endif
+
+typedef unsigned __int128 big_t;
+
+static uint64_t cnv_seed = 88172645463325252ULL;
+
+/* -------------------------------------------------------------------------- */
+/* random value of random length: the small values are tested too */
+
+static uint64_t cnv_rand( void )
+{
+	cnv_seed ^= cnv_seed << 13;
+	cnv_seed ^= cnv_seed >> 7;
+	cnv_seed ^= cnv_seed << 17;
+	return cnv_seed >> (cnv_seed % 64);
+}
+
+/* -------------------------------------------------------------------------- */
+/* the values around the multiples of 'd' and the ends of the range */
+
+static uint64_t cnv_value( unsigned i, uint64_t d, uint64_t max )
+{
+	uint64_t k = (uint64_t) 1 << (i / 3 % 64);
+
+	switch (i % 3)
+	{
+	case 0:  return i < 8 ? i : cnv_rand() & max;
+	case 1:  return max / d >= k ? k * d - 1 : max - i / 3;
+	default: return max / d >= k ? k * d     : max;
+	}
+}
+
+/*******************************************************************************
+ Division by constants
+*******************************************************************************/
+
+typedef struct
+{
+	uint32_t  d;
+	uint32_t (*div32)( uint32_t );
+	uint64_t (*div64)( uint64_t ); // NULL: d >= 2^16
+
+}	cnv_div_t;
+
+#define   CNV_DIV32(n, d) \
+	static uint32_t cnv_div32_##n( uint32_t x ) { return cnv_div32(x, d); }
+#define   CNV_DIV64(n, d) \
+	static uint64_t cnv_div64_##n( uint64_t x ) { return cnv_div64(x, d); }
+
+CNV_DIV32(1, 1U)          CNV_DIV64(1, 1U)
+CNV_DIV32(2, 3U)          CNV_DIV64(2, 3U)
+CNV_DIV32(3, 7U)          CNV_DIV64(3, 7U)
+CNV_DIV32(4, 10U)         CNV_DIV64(4, 10U)
+CNV_DIV32(5, 48U)         CNV_DIV64(5, 48U)
+CNV_DIV32(6, 1000U)       CNV_DIV64(6, 1000U)
+CNV_DIV32(7, 1024U)       CNV_DIV64(7, 1024U)
+CNV_DIV32(8, 48000U)      CNV_DIV64(8, 48000U)
+CNV_DIV32(9, 65535U)      CNV_DIV64(9, 65535U)
+CNV_DIV32(10, 65536U)
+CNV_DIV32(11, 1000000U)
+CNV_DIV32(12, 48000000U)
+CNV_DIV32(13, 0x80000001U)
+CNV_DIV32(14, 0xFFFFFFFFU)
+
+static const cnv_div_t cnv_divs[] =
+{
+	{ 1U,          cnv_div32_1,  cnv_div64_1 },
+	{ 3U,          cnv_div32_2,  cnv_div64_2 },
+	{ 7U,          cnv_div32_3,  cnv_div64_3 },
+	{ 10U,         cnv_div32_4,  cnv_div64_4 },
+	{ 48U,         cnv_div32_5,  cnv_div64_5 },
+	{ 1000U,       cnv_div32_6,  cnv_div64_6 },
+	{ 1024U,       cnv_div32_7,  cnv_div64_7 },
+	{ 48000U,      cnv_div32_8,  cnv_div64_8 },
+	{ 65535U,      cnv_div32_9,  cnv_div64_9 },
+	{ 65536U,      cnv_div32_10, NULL },
+	{ 1000000U,    cnv_div32_11, NULL },
+	{ 48000000U,   cnv_div32_12, NULL },
+	{ 0x80000001U, cnv_div32_13, NULL },
+	{ 0xFFFFFFFFU, cnv_div32_14, NULL },
+};
+
+static void cnv_test_div( void )
+{
+	const cnv_div_t *t;
+	uint64_t         x;
+	unsigned         i;
+
+	for (t = cnv_divs; t < cnv_divs + sizeof(cnv_divs) / sizeof(*cnv_divs); t++)
+	{
+		for (i = 0; i < CNV_RUNS; i++)
+		{
+			x = cnv_value(i, t->d, UINT32_MAX);
+			TEST_CHECK(t->div32((uint32_t) x) == (uint32_t) x / t->d);
+
+			if (t->div64 == NULL)
+				continue;
+
+			x = cnv_value(i, t->d, UINT64_MAX);
+			TEST_CHECK(t->div64(x) == x / t->d);
+		}
+	}
+}
+
+/*******************************************************************************
+ Conversions, for every argument with the result in the range of the type
+*******************************************************************************/
+
+static void cnv_test_conv( void )
+{
+	const uint64_t max = (tim_t) ~(tim_t) 0;
+	uint64_t       x;
+	unsigned       i;
+
+	for (i = 0; i < CNV_RUNS; i++)
+	{
+		x = cnv_value(i, CNV_CYC_US, UINT32_MAX);
+		TEST_CHECK(cnv_cyc2us((uint32_t) x) == x / CNV_CYC_US);
+
+		x = cnv_value(i, CNV_CYC_TCK, UINT32_MAX);
+		TEST_CHECK(cnv_cyc2tck((uint32_t) x) == x / CNV_CYC_TCK);
+
+		/* rounded up */
+		x = cnv_value(i, CNV_US_TCK, max);
+		TEST_CHECK(cnv_us2tck((tim_t) x) == ((big_t) x + CNV_US_TCK - 1) / CNV_US_TCK);
+
+		x = cnv_value(i, 1000, max);
+		if (((big_t) x * OS_FREQUENCY + 999) / 1000 <= max)
+			TEST_CHECK(cnv_ms2tck((tim_t) x) == ((big_t) x * OS_FREQUENCY + 999) / 1000);
+
+		/* rounded down */
+		x = cnv_value(i, OS_FREQUENCY, max);
+		if ((big_t) x * 1000 / OS_FREQUENCY <= max)
+			TEST_CHECK(cnv_tck2ms((tim_t) x) == (big_t) x * 1000 / OS_FREQUENCY);
+		if ((big_t) x * CNV_US_TCK <= max)
+			TEST_CHECK(cnv_tck2us((tim_t) x) == (big_t) x * CNV_US_TCK);
+	}
+}
+
+/******************************************************************************/
+
+int main()
+{
+	cnv_test_div();
+	cnv_test_conv();
+
+	TEST_PASS();
+}
+
+/******************************************************************************/
+
+#endif//HOST_TEST
@@ -0,0 +1,13 @@
+/*******************************************************************************
+@file     timeconv_f1.c
+@author   agent
+@date     19.10.2026
+@brief    Conversion test with OS_FREQUENCY 1 and the 64-bit system timer.
+*******************************************************************************/
+
+#define   TEST_FREQUENCY   1
+#define   TEST_TIMER_SIZE  64
+
+#include "timeconv.c"
+
+/******************************************************************************/
@@ -0,0 +1,13 @@
+/*******************************************************************************
+@file     timeconv_f100.c
+@author   agent
+@date     19.10.2026
+@brief    Conversion test with OS_FREQUENCY 100 and the 32-bit system timer.
+*******************************************************************************/
+
+#define   TEST_FREQUENCY   100
+#define   TEST_TIMER_SIZE  32
+
+#include "timeconv.c"
+
+/******************************************************************************/
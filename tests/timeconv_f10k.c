@@ -0,0 +1,13 @@
+/*******************************************************************************
+@file     timeconv_f10k.c
+@author   agent
+@date     19.10.2026
+@brief    Conversion test with OS_FREQUENCY 10000 and the 64-bit system timer.
+*******************************************************************************/
+
+#define   TEST_FREQUENCY   10000
+#define   TEST_TIMER_SIZE  64
+
+#include "timeconv.c"
+
+/******************************************************************************/
@@ -0,0 +1,151 @@
+/*******************************************************************************
+@file     usart.c
+@author   agent
+@date     19.10.2026
+@brief    USART driver test: loopback through the simulated DMA and the
+          overrun of the receive buffer.
+*******************************************************************************/
+
+#ifdef HOST_TEST
+
+#include "test.h"
+#include "usart.h"
+
+void USART1_IRQHandler( void );
+void DMA1_Channel2_3_IRQHandler( void );
+
+/* -------------------------------------------------------------------------- */
+/* the receiver: one byte written by the DMA channel 3 at the current position,
+   the half and full transfer interrupts at the ends of the halves */
+
+static void usart_rx_byte( uint8_t c )
+{
+	uint8_t *buf = (uint8_t *) DMA1_Channel3->CMAR;
+
+	buf[USART_RX_SIZE - DMA1_Channel3->CNDTR] = c;
+	if (--DMA1_Channel3->CNDTR == 0)
+		DMA1_Channel3->CNDTR = USART_RX_SIZE;
+
+	if (DMA1_Channel3->CNDTR == USART_RX_SIZE / 2)
+		DMA1->ISR |= DMA_ISR_HTIF3;
+	else
+	if (DMA1_Channel3->CNDTR == USART_RX_SIZE)
+		DMA1->ISR |= DMA_ISR_TCIF3;
+}
+
+/* -------------------------------------------------------------------------- */
+
+static void usart_rx_irq( void )
+{
+	sys_lock();
+	{
+		DMA1_Channel2_3_IRQHandler();
+		DMA1->ISR &= ~(DMA_ISR_GIF3 | DMA_ISR_HTIF3 | DMA_ISR_TCIF3);
+	}
+	sys_unlock();
+}
+
+/* -------------------------------------------------------------------------- */
+
+static void usart_rx_idle( void )
+{
+	sys_lock();
+	{
+		USART1->ISR |= USART_ISR_IDLE;
+		USART1_IRQHandler();
+		USART1->ISR &= ~USART_ISR_IDLE;
+	}
+	sys_unlock();
+}
+
+/* -------------------------------------------------------------------------- */
+/* the transmitter looped back to the receiver: the enabled DMA channel 2
+   is emptied byte by byte, then the transfer complete interrupt */
+
+static void usart_hw( void )
+{
+	for (;;)
+	{
+		if (DMA1_Channel2->CCR & DMA_CCR_EN)
+		{
+			const uint8_t *buf = (const uint8_t *) DMA1_Channel2->CMAR;
+
+			while (DMA1_Channel2->CNDTR > 0)
+			{
+				usart_rx_byte(*buf++);
+				DMA1_Channel2->CNDTR--;
+				if (DMA1->ISR & (DMA_ISR_HTIF3 | DMA_ISR_TCIF3))
+					usart_rx_irq();
+			}
+
+			sys_lock();
+			{
+				DMA1->ISR |= DMA_ISR_TCIF2;
+				DMA1_Channel2_3_IRQHandler();
+				DMA1->ISR &= ~(DMA_ISR_GIF2 | DMA_ISR_TCIF2);
+			}
+			sys_unlock();
+			usart_rx_idle();
+		}
+		tsk_delay(1);
+	}
+}
+
+static_TSK(usart_hw_task, OS_MAIN_PRIO + 1, usart_hw);
+
+/******************************************************************************/
+
+static uint8_t usart_out[USART_RX_SIZE * 3];
+static uint8_t usart_in [USART_RX_SIZE * 3];
+
+int main()
+{
+	unsigned i, n, len;
+
+	usart_init(115200);
+	TEST_CHECK(USART1->BRR == (CPU_FREQUENCY + 115200 / 2) / 115200);
+	TEST_CHECK(usart_read(usart_in, sizeof(usart_in), IMMEDIATE) == 0);
+
+	tsk_start(usart_hw_task);
+
+	for (i = 0; i < sizeof(usart_out); i++)
+		usart_out[i] = (uint8_t)(i * 7 + 1);
+
+	/* loopback of frames of different lengths, across the end of the buffer */
+	for (n = 1; n < USART_RX_SIZE; n += 37)
+	{
+		TEST_CHECK(usart_write(usart_out, n, SEC) == E_SUCCESS);
+		for (len = 0; len < n; len += i)
+			TEST_CHECK((i = usart_read(usart_in + len, n - len, SEC)) > 0);
+		TEST_CHECK(len == n);
+		TEST_CHECK(memcmp(usart_in, usart_out, n) == 0);
+	}
+	TEST_CHECK(usart_read(usart_in, sizeof(usart_in), IMMEDIATE) == 0);
+	TEST_CHECK(usart_lost() == 0);
+
+	/* a frame of the size of the buffer, read at once: no overrun yet */
+	TEST_CHECK(usart_write(usart_out, USART_RX_SIZE - 1, SEC) == E_SUCCESS);
+	TEST_CHECK(usart_read(usart_in, sizeof(usart_in), IMMEDIATE) == USART_RX_SIZE - 1);
+	TEST_CHECK(usart_lost() == 0);
+
+	/* the reader does not keep up: the last half of the buffer is returned */
+	n = USART_RX_SIZE * 2 + 10;
+	TEST_CHECK(usart_write(usart_out, n, SEC) == E_SUCCESS);
+	len = usart_read(usart_in, sizeof(usart_in), IMMEDIATE);
+	TEST_CHECK(len == USART_RX_SIZE / 2);
+	TEST_CHECK(memcmp(usart_in, usart_out + n - len, len) == 0);
+	TEST_CHECK(usart_lost() == n - len);
+	TEST_CHECK(usart_read(usart_in, sizeof(usart_in), IMMEDIATE) == 0);
+
+	/* the reception continues normally after the overrun */
+	TEST_CHECK(usart_write(usart_out, 20, SEC) == E_SUCCESS);
+	TEST_CHECK(usart_read(usart_in, sizeof(usart_in), IMMEDIATE) == 20);
+	TEST_CHECK(memcmp(usart_in, usart_out, 20) == 0);
+	TEST_CHECK(usart_lost() == n - USART_RX_SIZE / 2);
+
+	TEST_PASS();
+}
+
+/******************************************************************************/
+
+#endif//HOST_TEST
@@ -0,0 +1,112 @@
+#!/usr/bin/env python3
+#**********************************************************#
+#file     logdecode.py
+#author   agent
+#date     18.10.2026
+#brief    Decoder of the binary log stream (utils/log.c).
+#         usage: logdecode.py firmware.elf [stream.bin]
+#         the stream is read from stdin if no file is given
+#**********************************************************#
+
+import re
+import struct
+import sys
+
+LOG_SYNC = 0xA5
+LOG_LOST = 0xF
+
+#----------------------------------------------------------#
+
+class Elf:
+    """Minimal reader of the sections of a 32-bit little-endian ELF file."""
+
+    def __init__(self, path):
+        with open(path, 'rb') as f:
+            self.data = f.read()
+        if self.data[:4] != b'\x7fELF' or self.data[4] != 1 or self.data[5] != 1:
+            raise SystemExit('%s: not a 32-bit little-endian ELF file' % path)
+        shoff, = struct.unpack_from('<I', self.data, 0x20)
+        shentsize, shnum, shstrndx = struct.unpack_from('<HHH', self.data, 0x2E)
+        hdrs = [struct.unpack_from('<IIIIIIIIII', self.data, shoff + i * shentsize) for i in range(shnum)]
+        names = hdrs[shstrndx][4]
+        self.sections = []
+        for name, typ, flags, addr, offset, size, *_ in hdrs:
+            end = self.data.index(b'\0', names + name)
+            self.sections.append((self.data[names + name:end].decode(), typ, addr, offset, size))
+
+    def string(self, addr, name=None):
+        for sname, typ, saddr, offset, size in self.sections:
+            if typ == 8 or (name is not None and sname != name):
+                continue # SHT_NOBITS
+            if saddr <= addr < saddr + size:
+                pos = offset + addr - saddr
+                return self.data[pos:self.data.index(b'\0', pos)].decode(errors='replace')
+        return None
+
+    def format(self, ident):
+        fmt = self.string(ident, '.logstr')
+        if fmt is None:
+            # format strings kept in flash (toolchains without '.logstr')
+            fmt = self.string(0x08000000 | ident)
+        return fmt
+
+#----------------------------------------------------------#
+
+CONV = re.compile(r'%([-+ #0]*\d*(?:\.\d+)?)(hh|h|ll|l|z|j|t)?([diouxXc%])')
+
+def render(fmt, args):
+    args = list(args)
+    def conv(m):
+        flags, _, spec = m.groups()
+        if spec == '%':
+            return '%'
+        val = args.pop(0) if args else 0
+        if spec in 'di' and val & 0x80000000:
+            val -= 1 << 32
+        return ('%' + flags + spec) % val
+    return CONV.sub(conv, fmt)
+
+#----------------------------------------------------------#
+
+def words(stream):
+    while True:
+        w = stream.read(4)
+        if len(w) < 4:
+            return
+        yield struct.unpack('<I', w)[0]
+
+def decode(elf, stream, out):
+    it = words(stream)
+    for hdr in it:
+        if hdr >> 24 != LOG_SYNC:
+            continue # resynchronize
+        cnt = (hdr >> 20) & 0xF
+        ident = hdr & 0xFFFFF
+        if cnt == LOG_LOST:
+            out.write('<%d records lost>\n' % ident)
+            continue
+        try:
+            stamp = next(it)
+            args = [next(it) for _ in range(cnt)]
+        except StopIteration:
+            return
+        fmt = elf.format(ident)
+        if fmt is None:
+            out.write('%10u: <unknown format 0x%05X> %s\n' % (stamp, ident, ' '.join('0x%08X' % a for a in args)))
+        else:
+            out.write('%10u: %s\n' % (stamp, render(fmt, args)))
+
+#----------------------------------------------------------#
+
+def main(argv):
+    if len(argv) not in (2, 3):
+        raise SystemExit('usage: logdecode.py firmware.elf [stream.bin]')
+    elf = Elf(argv[1])
+    if len(argv) == 3:
+        with open(argv[2], 'rb') as stream:
+            decode(elf, stream, sys.stdout)
+    else:
+        decode(elf, sys.stdin.buffer, sys.stdout)
+
+if __name__ == '__main__':
+    main(sys.argv)
@@ -0,0 +1,147 @@
+#!/usr/bin/env python3
+#**********************************************************#
+#file     matrix.py
+#author   agent
+#date     18.10.2026
+#brief    Toolchain matrix: the kernel benchmark (utils/bench.h) is built
+#         with every toolchain found on the machine, run under qemu with
+#         deterministic time (-icount) and the results are tabulated:
+#         flash, RAM (stacks included) and cycles per operation.
+#         usage: matrix.py [toolchain ...]   (default: all found)
+#         toolchains: gnucc, llvm, clang (armclang), armcc, iarcc
+#         the compilers are searched in PATH, qemu-system-gnuarmeclipse
+#         too (or given with the QEMU environment variable);
+#         ICOUNT (environment, default 4): one instruction takes 2^ICOUNT ns
+#         DEFS (environment): added to every build, e.g. DEFS=USE_FAST_MEM
+#         compares utils/fastmem.c with the library (memcpy... results)
+#         run from the project directory; the objects are rebuilt
+#         for each toolchain (make clean)
+#**********************************************************#
+
+import os
+import shutil
+import struct
+import subprocess
+import sys
+
+PROJECT = 'bench'
+FLASH   = (0x08000000, 0x08100000)
+RAM     = (0x20000000, 0x20100000)
+
+#name, makefile, image, variable of the compiler: program, DEFS
+TOOLCHAINS = (
+    ('gnucc', 'makefile.gnucc', '.elf', (('GNUCC', 'arm-none-eabi-gcc'),),
+        'USE_NANO USE_SEMIHOST USE_BENCH USE_HSM'),
+    ('llvm',  'makefile.llvm',  '.elf', (('LLVM', 'clang'), ('GNUCC', 'arm-none-eabi-gcc')),
+        'USE_NANO USE_SEMIHOST USE_BENCH USE_HSM'),
+    ('clang', 'makefile.clang', '.axf', (('CLANG', 'armclang'),),
+        '__MICROLIB USE_BENCH USE_HSM'),  # default library, fputc retargeted by bench.c
+    ('armcc', 'makefile.armcc', '.axf', (('ARMCC', 'armcc'),),
+        '__MICROLIB USE_BENCH USE_HSM'),
+    ('iarcc', 'makefile.iarcc', '.elf', (('IARCC', 'iccarm'),),
+        'port_sys_init=__iar_init_core USE_SEMIHOST USE_BENCH USE_HSM'),
+)
+
+#----------------------------------------------------------#
+
+def prefix(var, program):
+    """Value of the make variable: the directory of the program, or the
+       whole prefix of the GNU tools (.../arm-none-eabi-)."""
+    path = shutil.which(program)
+    if path is None:
+        return None
+    if var == 'GNUCC':
+        return path[:-len('gcc')]
+    return os.path.dirname(path) + '/'
+
+#----------------------------------------------------------#
+
+def elf_size(path):
+    """Flash and RAM of the image from the program headers of the ELF file."""
+    with open(path, 'rb') as f:
+        data = f.read()
+    if data[:4] != b'\x7fELF' or data[4] != 1 or data[5] != 1:
+        raise SystemExit('%s: not a 32-bit little-endian ELF file' % path)
+    phoff, = struct.unpack_from('<I', data, 0x1C)
+    phentsize, phnum = struct.unpack_from('<HH', data, 0x2A)
+    flash = ram = 0
+    for i in range(phnum):
+        typ, offset, vaddr, paddr, filesz, memsz, flags, align = struct.unpack_from('<IIIIIIII', data, phoff + i * phentsize)
+        if typ != 1: # PT_LOAD
+            continue
+        if FLASH[0] <= paddr < FLASH[1]:
+            flash += filesz
+        if RAM[0] <= vaddr < RAM[1]:
+            ram += memsz
+    return flash, ram
+
+#----------------------------------------------------------#
+
+def make(makefile, env, args):
+    cmd = ['make', '-s', '-f', makefile] + args
+    return subprocess.run(cmd, env=env, stdout=subprocess.DEVNULL, stderr=subprocess.PIPE, universal_newlines=True)
+
+def run(name, makefile, ext, tools, defs, qemu, icount):
+    env = dict(os.environ, PROJECT=PROJECT, DEFS=' '.join((os.environ.get('DEFS', ''), defs)).strip()) # the makefiles append to DEFS
+    args = []
+    for var, program in tools:
+        value = prefix(var, program)
+        if value is None:
+            return None
+        args.append('%s=%s' % (var, value))
+    image = PROJECT + ext
+
+    make(makefile, env, args + ['clean'])
+    result = make(makefile, env, args + [image])
+    if result.returncode != 0 or not os.path.exists(image):
+        sys.stderr.write('%s: build failed\n%s' % (name, result.stderr))
+        return {}
+
+    flash, ram = elf_size(image)
+    row = { 'flash': flash, 'ram': ram }
+    try:
+        out = subprocess.run(qemu + ['-image', image, '-icount', 'shift=%s,align=off,sleep=off' % icount],
+                             stdout=subprocess.PIPE, stderr=subprocess.DEVNULL, universal_newlines=True, timeout=120).stdout
+    except subprocess.TimeoutExpired:
+        sys.stderr.write('%s: emulation timed out\n' % name)
+        out = ''
+    for line in out.splitlines():
+        line = line.split()
+        if len(line) == 3 and line[0] == 'bench':
+            row[line[1]] = int(line[2])
+    make(makefile, env, args + ['clean'])
+    return row
+
+#----------------------------------------------------------#
+
+def main(argv):
+    names  = argv or [t[0] for t in TOOLCHAINS]
+    icount = os.environ.get('ICOUNT', '4')
+    qemu   = os.environ.get('QEMU', '').split() or [shutil.which('qemu-system-gnuarmeclipse') or 'qemu-system-gnuarmeclipse']
+    qemu  += ['-semihosting', '-board', 'STM32F0-Discovery', '-nographic']
+
+    rows = []
+    for name, makefile, ext, tools, defs in TOOLCHAINS:
+        if name not in names:
+            continue
+        row = run(name, makefile, ext, tools, defs, qemu, icount)
+        if row is None:
+            print('%s: not found, skipped' % name)
+        elif row:
+            rows.append((name, row))
+
+    if not rows:
+        print('no results')
+        return 1
+
+    tests = sorted({ k for _, row in rows for k in row } - { 'flash', 'ram' })
+    print('%-8s %8s %8s' % ('', 'flash', 'ram') + ''.join(' %8s' % t for t in tests))
+    for name, row in rows:
+        print('%-8s %8u %8u' % (name, row['flash'], row['ram']) + ''.join(' %8s' % row.get(t, '-') for t in tests))
+    print('(%s: cycles per operation, qemu -icount shift=%s)' % (', '.join(tests), icount))
+    return 0
+
+#----------------------------------------------------------#
+
+if __name__ == '__main__':
+    sys.exit(main(sys.argv[1:]))
@@ -0,0 +1,204 @@
+#!/usr/bin/env python3
+#**********************************************************#
+#file     sizereport.py
+#author   agent
+#date     18.10.2026
+#brief    Flash / RAM report per module from the linker map file (GNU ld).
+#         usage: sizereport.py firmware.map [baseline [budget]]
+#                sizereport.py --update firmware.map baseline
+#         modules: kernel (StateOS), startup, cmsis, application,
+#         library (toolchain libraries), stacks, other (linker padding)
+#         the sizes are compared with the baseline (growth is a warning)
+#         and checked against the budget (overrun is an error, exit 1);
+#         --update writes the current sizes as the new baseline
+#**********************************************************#
+
+import os
+import re
+import sys
+
+MODULES = ('kernel', 'startup', 'cmsis', 'application', 'library', 'stacks', 'other')
+
+#----------------------------------------------------------#
+
+def module(path):
+    path = path.replace('\\', '/')
+    if os.path.basename(path).startswith('system_'):
+        return 'cmsis' # system file of the device (startup directory)
+    for key, name in (('StateOS/', 'kernel'), ('startup/', 'startup'), ('CMSIS/', 'cmsis')):
+        if path.startswith(key) or ('/' + key) in path:
+            return name
+    if path.endswith(')') or os.path.isabs(path) or re.match(r'^[A-Za-z]:/', path):
+        return 'library' # archive member or a file of the toolchain
+    return 'application'
+
+#----------------------------------------------------------#
+
+class MapFile:
+    """Sizes of the modules from the 'Memory Configuration' and 'Linker script
+       and memory map' parts of the map file."""
+
+    HEX = r'0x([0-9a-fA-F]+)'
+
+    def __init__(self, path):
+        with open(path) as f:
+            self.lines = f.read().splitlines()
+        self.regions = []
+        self.flash = dict.fromkeys(MODULES, 0)
+        self.ram   = dict.fromkeys(MODULES, 0)
+        self.parse_regions()
+        self.parse_sections()
+
+    def parse_regions(self):
+        found = False
+        for line in self.lines:
+            if line.startswith('Memory Configuration'):
+                found = True
+            elif line.startswith('Linker script and memory map'):
+                break
+            elif found:
+                m = re.match(r'^(\S+)\s+' + self.HEX + r'\s+' + self.HEX + r'\s*(\S*)', line)
+                if m and m.group(1) != '*default*':
+                    # a region without the 'w' attribute is the flash
+                    self.regions.append((int(m.group(2), 16), int(m.group(3), 16), 'w' not in m.group(4)))
+        if not self.regions:
+            raise SystemExit('no memory regions in the map file')
+
+    def region(self, addr):
+        for origin, length, flash in self.regions:
+            if origin <= addr < origin + length:
+                return 'flash' if flash else 'ram'
+        return None
+
+    def add(self, out, name, size):
+        vma, lma = out['vma'], out['lma']
+        if vma == 'flash' or lma == 'flash':
+            self.flash[name] += size
+        if vma == 'ram':
+            self.ram[name] += size
+
+    def close(self, out):
+        if out and out['used'] < out['size']:
+            self.add(out, 'stacks' if 'stack' in out['name'] else 'other', out['size'] - out['used'])
+
+    def parse_sections(self):
+        start = self.lines.index('Linker script and memory map') if 'Linker script and memory map' in self.lines else 0
+        out, fill, pending = None, 0, None
+        for line in self.lines[start + 1:]:
+            if pending is not None: # the name of the section was too long, the rest is in this line
+                line, pending = pending + ' ' + line.strip(), None
+            # output section: name at the beginning of the line
+            m = re.match(r'^([.\w]\S*)(?:\s+' + self.HEX + r'\s+' + self.HEX + r'(?:\s+load address ' + self.HEX + r')?)?\s*$', line)
+            if m and not line.startswith(('LOAD ', 'OUTPUT(', 'START ', 'END ')):
+                if m.group(2) is None:
+                    if line.startswith('.'):
+                        pending = line.strip()
+                    continue
+                self.close(out)
+                fill = 0
+                vma = int(m.group(2), 16)
+                out = { 'name': m.group(1), 'size': int(m.group(3), 16), 'used': 0,
+                        'vma': self.region(vma), 'lma': self.region(int(m.group(4), 16)) if m.group(4) else None }
+                continue
+            if out is None or not line.startswith(' ') or line.startswith(' *('):
+                continue
+            # input section: ' name addr size file' or ' *fill* addr size'
+            m = re.match(r'^ (\S+)(?:\s+' + self.HEX + r'\s+' + self.HEX + r'(?:\s+(.*\S))?)?\s*$', line)
+            if not m:
+                continue
+            if m.group(2) is None:
+                if not m.group(1).startswith('0x'):
+                    pending = line.rstrip()
+                continue
+            size = int(m.group(3), 16)
+            if size == 0:
+                continue
+            if m.group(1) == '*fill*':
+                fill += size # alignment of the next input section or space reserved by the script
+                continue
+            if not m.group(4):
+                continue
+            size += fill
+            out['used'] += size
+            self.add(out, module(m.group(4)), size)
+            fill = 0
+        self.close(out)
+
+#----------------------------------------------------------#
+
+def read_table(path):
+    table = {}
+    if path and os.path.exists(path):
+        with open(path) as f:
+            for line in f:
+                line = line.split('#')[0].split()
+                if len(line) == 3: # '-': not checked
+                    table[line[0]] = tuple(None if v == '-' else int(v) for v in line[1:])
+    return table
+
+def write_table(path, sizes):
+    header = []
+    if os.path.exists(path): # the comment block of the file is kept
+        with open(path) as f:
+            for line in f:
+                if not line.startswith('#') or line.startswith('#module'):
+                    break
+                header.append(line)
+    with open(path, 'w') as f:
+        f.write(''.join(header) + ('\n' if header else '') + '#module          flash      ram\n')
+        for name in MODULES:
+            f.write('%-12s %10u %8u\n' % ((name,) + sizes[name]))
+
+def diff(size, base):
+    return '%+d' % (size - base) if base is not None else '-'
+
+#----------------------------------------------------------#
+
+def main(argv):
+    update = '--update' in argv
+    args = [a for a in argv if a != '--update']
+    if not args or (update and len(args) != 2):
+        raise SystemExit('usage: sizereport.py firmware.map [baseline [budget]]\n       sizereport.py --update firmware.map baseline')
+
+    m = MapFile(args[0])
+    sizes = { name: (m.flash[name], m.ram[name]) for name in MODULES }
+
+    if update:
+        write_table(args[1], sizes)
+        print('Baseline written: %s' % args[1])
+        return 0
+
+    base   = read_table(args[1] if len(args) > 1 else None)
+    budget = read_table(args[2] if len(args) > 2 else None)
+
+    errors = 0
+    print('%-12s %8s %8s %8s  %8s %8s %8s' % ('module', 'flash', 'diff', 'budget', 'ram', 'diff', 'budget'))
+    for name in MODULES:
+        flash, ram = sizes[name]
+        b = base.get(name, (None, None))
+        l = budget.get(name, (None, None))
+        print('%-12s %8u %8s %8s  %8u %8s %8s' % (name,
+              flash, diff(flash, b[0]), l[0] if l[0] is not None else '-',
+              ram,   diff(ram,   b[1]), l[1] if l[1] is not None else '-'))
+    total_flash = sum(s[0] for s in sizes.values())
+    total_ram   = sum(s[1] for s in sizes.values())
+    print('%-12s %8u %8s %8s  %8u %8s %8s' % ('total', total_flash, '', '', total_ram, '', ''))
+
+    for name in MODULES:
+        for i, mem in enumerate(('flash', 'RAM')):
+            size = sizes[name][i]
+            if budget.get(name, (None, None))[i] is not None and size > budget[name][i]:
+                print('error: %s %s %u exceeds the budget %u' % (name, mem, size, budget[name][i]))
+                errors += 1
+            elif base.get(name, (None, None))[i] is not None and size > base[name][i]:
+                print('warning: %s %s grew by %u bytes' % (name, mem, size - base[name][i]))
+
+    if not any(v is not None for b in base.values() for v in b):
+        print('note: no baseline recorded, run make sizebaseline')
+
+    return 1 if errors else 0
+
+#----------------------------------------------------------#
+
+if __name__ == '__main__':
+    sys.exit(main(sys.argv[1:]))
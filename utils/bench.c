@@ -0,0 +1,496 @@
+/*******************************************************************************
+@file     bench.c
+@author   agent
+@date     18.10.2026
+@brief    Kernel benchmark application (tools/matrix.py).
+*******************************************************************************/
+
+#ifdef USE_BENCH
+
+#include "bench.h"
+#include "semihost.h"
+#include <stm32f0xx.h>
+#ifdef USE_HSM
+#include "hsm.h"
+#endif
+#ifdef USE_ADC
+#include "adc.h"
+#endif
+#ifdef USE_CRC
+#include "crc.h"
+#endif
+#ifdef USE_PACKET
+#include "packet.h"
+#endif
+#ifdef USE_CEILING
+#include "ceiling.h"
+#endif
+#include <stdio.h>
+#include <string.h>
+
+static_SEM(bench_ping, 0, semBinary);
+static_SEM(bench_pong, 0, semBinary);
+
+/* -------------------------------------------------------------------------- */
+/* microlib has no semihosting: the output of printf is written to the host
+   console one character at a time */
+
+#ifdef __MICROLIB
+
+int fputc( int c, FILE *f )
+{
+	(void) f;
+	semihost_putc((char) c);
+	return c;
+}
+
+#endif
+
+/* -------------------------------------------------------------------------- */
+
+static void bench_partner( void )
+{
+	for (;;)
+	{
+		sem_wait(bench_ping);
+		sem_give(bench_pong);
+	}
+}
+
+static_TSK(bench_task, BENCH_PRIO, bench_partner);
+
+/* -------------------------------------------------------------------------- */
+/* cpu cycles: the system tick counter and the SysTick down-counter (Cortex-M0
+   has no DWT cycle counter); a tick already pending in the critical section
+   is not counted yet by the kernel and is added here */
+
+uint64_t bench_start( void )
+{
+	uint32_t load = SysTick->LOAD + 1;
+	uint32_t val;
+	uint64_t time;
+
+	sys_lock();
+	{
+		time = sys_time();
+		val  = SysTick->VAL;
+		if ((SCB->ICSR & SCB_ICSR_PENDSTSET_Msk) && val > load / 2)
+			time++;
+	}
+	sys_unlock();
+
+	return time * load + (load - 1 - val);
+}
+
+/* -------------------------------------------------------------------------- */
+
+void bench_print( const char *name, uint64_t start, unsigned loops )
+{
+	uint64_t cycles = bench_start() - start;
+
+	printf("bench %s %lu\n", name, (unsigned long)(cycles / loops));
+}
+
+/* -------------------------------------------------------------------------- */
+/* busy loop of the main task (the lowest priority) for the 'time';
+   return: number of the loops, proportional to the cpu time left */
+
+static unsigned long bench_spin( cnt_t time )
+{
+	unsigned long cnt   = 0;
+	cnt_t         start = sys_time();
+
+	/* from the beginning of a tick */
+	while (sys_time() == start);
+	start++;
+
+	while (sys_time() - start < time)
+		cnt++;
+
+	return cnt;
+}
+
+/* -------------------------------------------------------------------------- */
+/* acquisition throughput: the consumer task sums each block of samples,
+   the cpu load is the part of the time taken from the main task */
+
+#ifdef USE_ADC
+
+static volatile uint32_t bench_adc_sum;
+
+static void bench_adc_consumer( void )
+{
+	for (;;)
+	{
+		uint16_t *blk = adc_wait(INFINITE);
+		uint32_t  sum = 0;
+		unsigned  i;
+
+		for (i = 0; i < ADC_BLOCK; i++)
+			sum += blk[i];
+
+		bench_adc_sum = sum;
+	}
+}
+
+static_TSK(bench_adc_task, BENCH_PRIO, bench_adc_consumer);
+
+static void bench_adc( void )
+{
+	static const unsigned rates[] = { 50000, 100000, 200000, 400000 };
+
+	unsigned long full = bench_spin(BENCH_TIME);
+	unsigned long left;
+	uint32_t      blocks, lost;
+	unsigned      i;
+
+	tsk_start(bench_adc_task);
+
+	for (i = 0; i < sizeof(rates) / sizeof(*rates); i++)
+	{
+		adc_init(ADC_CHSELR_CHSEL0, rates[i]);
+		blocks = adc_blocks();
+		lost   = adc_overruns();
+		left   = bench_spin(BENCH_TIME);
+		blocks = adc_blocks() - blocks;
+		lost   = adc_overruns() - lost;
+		adc_stop();
+
+		printf("bench adc%uk %lu\n",      rates[i] / 1000, (unsigned long)((unsigned long long) blocks * ADC_BLOCK * SEC / BENCH_TIME));
+		printf("bench adc%uk_load %lu\n", rates[i] / 1000, left < full ? (unsigned long)(10000 - (unsigned long long) left * 10000 / full) : 0UL);
+		printf("bench adc%uk_lost %lu\n", rates[i] / 1000, (unsigned long) lost);
+	}
+}
+
+#endif//USE_ADC
+
+/* -------------------------------------------------------------------------- */
+/* crc of the beginning of the flash: the hardware unit (by the cpu below
+   CRC_DMA_MIN bytes, by DMA above) against a table-driven software crc */
+
+#ifdef USE_CRC
+
+static uint32_t          bench_crc_table[256];
+static volatile uint32_t bench_crc_sum;
+
+static uint32_t bench_crc_sw( const uint8_t *data, size_t size )
+{
+	uint32_t crc = 0xFFFFFFFF;
+
+	while (size--)
+		crc = bench_crc_table[(crc ^ *data++) & 0xFF] ^ (crc >> 8);
+
+	return ~crc;
+}
+
+static void bench_crc( void )
+{
+	static const size_t sizes[] = { 256, 4096 };
+
+	const uint8_t *data = (const uint8_t *) FLASH_BASE;
+	char           name[16];
+	uint64_t       start;
+	uint32_t       crc;
+	unsigned       i, j, k;
+
+	for (i = 0; i < 256; i++)
+	{
+		for (crc = i, k = 0; k < 8; k++)
+			crc = (crc >> 1) ^ (0xEDB88320 & (0U - (crc & 1)));
+		bench_crc_table[i] = crc;
+	}
+
+	for (i = 0; i < sizeof(sizes) / sizeof(*sizes); i++)
+	{
+		printf("bench crc%u_ok %d\n", (unsigned) sizes[i], crc_calc(data, sizes[i]) == bench_crc_sw(data, sizes[i]));
+
+		start = bench_start();
+		for (j = 0; j < BENCH_LOOPS / 100; j++)
+			bench_crc_sum = crc_calc(data, sizes[i]);
+		sprintf(name, "crc%u_hw", (unsigned) sizes[i]);
+		bench_print(name, start, BENCH_LOOPS / 100);
+
+		start = bench_start();
+		for (j = 0; j < BENCH_LOOPS / 100; j++)
+			bench_crc_sum = bench_crc_sw(data, sizes[i]);
+		sprintf(name, "crc%u_sw", (unsigned) sizes[i]);
+		bench_print(name, start, BENCH_LOOPS / 100);
+	}
+}
+
+#endif//USE_CRC
+
+/* -------------------------------------------------------------------------- */
+/* state machine: the event toggles between two leaf states of different parents,
+   every dispatch exits two states and enters two (depth 3); the event is
+   dispatched at once and through the queue of the machine */
+
+#ifdef USE_HSM
+
+static hsm_t       bench_hsm[1];
+static hsm_event_t bench_hsm_queue[1];
+
+static const hsm_state_t bench_top, bench_a, bench_a1, bench_b, bench_b1;
+
+static const hsm_tran_t bench_a1_tran[] = { { hsmUser, NULL, NULL, &bench_b1 }, HSM_END };
+static const hsm_tran_t bench_b_tran[]  = { { hsmUser, NULL, NULL, &bench_a  }, HSM_END };
+
+static const hsm_state_t bench_top = _HSM_STATE(NULL,       &bench_a,  NULL, NULL, NULL);
+static const hsm_state_t bench_a   = _HSM_STATE(&bench_top, &bench_a1, NULL, NULL, NULL);
+static const hsm_state_t bench_a1  = _HSM_STATE(&bench_a,   NULL,      NULL, NULL, bench_a1_tran);
+static const hsm_state_t bench_b   = _HSM_STATE(&bench_top, &bench_b1, NULL, NULL, bench_b_tran);
+static const hsm_state_t bench_b1  = _HSM_STATE(&bench_b,   NULL,      NULL, NULL, NULL);
+
+static void bench_machine( void )
+{
+	uint64_t start;
+	unsigned i;
+
+	hsm_init(bench_hsm, &bench_top, bench_hsm_queue, sizeof(bench_hsm_queue));
+	start = bench_start();
+	for (i = 0; i < BENCH_LOOPS; i++)
+	{
+		hsm_event_t evt = { hsmUser, 0 };
+		hsm_dispatch(bench_hsm, &evt);
+	}
+	bench_print("hsm", start, BENCH_LOOPS);
+
+	start = bench_start();
+	for (i = 0; i < BENCH_LOOPS; i++)
+	{
+		hsm_give(bench_hsm, hsmUser, 0);
+		hsm_waitFor(bench_hsm, IMMEDIATE);
+	}
+	bench_print("hsmq", start, BENCH_LOOPS);
+}
+
+#endif//USE_HSM
+
+/* -------------------------------------------------------------------------- */
+/* message of 'size' bytes sent and received by the main task, no context switch:
+   the mailbox queue copies the message in and out, the packet channel passes
+   the pointer to the buffer of the pool */
+
+#ifdef USE_PACKET
+
+#define BENCH_PKT_MAX   256
+#define BENCH_PKT_COUNT   2
+
+static uint8_t  bench_box_buf[BENCH_PKT_COUNT * BENCH_PKT_MAX];
+static uint8_t  bench_box_msg[BENCH_PKT_MAX];
+static uint32_t bench_pkt_buf[BENCH_PKT_COUNT * PKT_WORDS(BENCH_PKT_MAX)];
+
+static box_t      bench_box[1];
+static pkt_pool_t bench_pool[1];
+static pkt_chan_t bench_chan[1];
+
+static void bench_packet( void )
+{
+	static const unsigned sizes[] = { 64, 256 };
+
+	char     name[16];
+	uint64_t start;
+	void    *pkt;
+	unsigned i, j;
+
+	for (i = 0; i < sizeof(sizes) / sizeof(*sizes); i++)
+	{
+		box_init(bench_box, sizes[i], bench_box_buf, BENCH_PKT_COUNT * sizes[i]);
+		start = bench_start();
+		for (j = 0; j < BENCH_LOOPS; j++)
+		{
+			box_give(bench_box, bench_box_msg);
+			box_take(bench_box, bench_box_msg);
+		}
+		sprintf(name, "box%u", sizes[i]);
+		bench_print(name, start, BENCH_LOOPS);
+
+		pkt_poolInit(bench_pool, bench_pkt_buf, BENCH_PKT_COUNT, sizes[i]);
+		pkt_chanInit(bench_chan);
+		start = bench_start();
+		for (j = 0; j < BENCH_LOOPS; j++)
+		{
+			pkt = pkt_alloc(bench_pool, IMMEDIATE);
+			pkt_send(bench_chan, pkt);
+			pkt = pkt_recv(bench_chan, IMMEDIATE);
+			pkt_free(pkt);
+		}
+		sprintf(name, "pkt%u", sizes[i]);
+		bench_print(name, start, BENCH_LOOPS);
+	}
+}
+
+#endif//USE_PACKET
+
+/* -------------------------------------------------------------------------- */
+/* mutex lock and unlock by the main task: uncontended, and contended by the
+   partner task of a higher priority woken while the mutex is held; the kernel
+   mutex (priority inheritance) blocks the partner and raises the owner, the
+   ceiling mutex runs the owner at the ceiling, so the partner runs only after
+   the unlock and finds the mutex free */
+
+#ifdef USE_CEILING
+
+static_MTX(bench_mtx, mtxPrioInherit);
+static_CMX(bench_cmx, BENCH_PRIO);
+static_SEM(bench_mtx_go, 0, semBinary);
+static_SEM(bench_cmx_go, 0, semBinary);
+
+static void bench_mtx_partner( void )
+{
+	for (;;)
+	{
+		sem_wait(bench_mtx_go);
+		mtx_wait(bench_mtx);
+		mtx_give(bench_mtx);
+	}
+}
+
+static void bench_cmx_partner( void )
+{
+	for (;;)
+	{
+		sem_wait(bench_cmx_go);
+		cmx_wait(bench_cmx);
+		cmx_give(bench_cmx);
+	}
+}
+
+static_TSK(bench_mtx_task, BENCH_PRIO, bench_mtx_partner);
+static_TSK(bench_cmx_task, BENCH_PRIO, bench_cmx_partner);
+
+static void bench_ceiling( void )
+{
+	uint64_t start;
+	unsigned i;
+
+	start = bench_start();
+	for (i = 0; i < BENCH_LOOPS; i++)
+	{
+		mtx_wait(bench_mtx);
+		mtx_give(bench_mtx);
+	}
+	bench_print("mtx", start, BENCH_LOOPS);
+
+	start = bench_start();
+	for (i = 0; i < BENCH_LOOPS; i++)
+	{
+		cmx_wait(bench_cmx);
+		cmx_give(bench_cmx);
+	}
+	bench_print("cmx", start, BENCH_LOOPS);
+
+	tsk_start(bench_mtx_task);
+	tsk_start(bench_cmx_task);
+
+	start = bench_start();
+	for (i = 0; i < BENCH_LOOPS; i++)
+	{
+		mtx_wait(bench_mtx);
+		sem_give(bench_mtx_go);
+		mtx_give(bench_mtx);
+	}
+	bench_print("mtx_cont", start, BENCH_LOOPS);
+
+	start = bench_start();
+	for (i = 0; i < BENCH_LOOPS; i++)
+	{
+		cmx_wait(bench_cmx);
+		sem_give(bench_cmx_go);
+		cmx_give(bench_cmx);
+	}
+	bench_print("cmx_cont", start, BENCH_LOOPS);
+}
+
+#endif//USE_CEILING
+
+/* -------------------------------------------------------------------------- */
+/* block copy and fill of BENCH_MEM bytes (from the flash to the ram); built
+   with and without USE_FAST_MEM it compares utils/fastmem.c with the library;
+   bytes per cycle: BENCH_MEM / result */
+
+static uint8_t         bench_mem[BENCH_MEM + 4];
+static volatile size_t bench_mem_size = BENCH_MEM; // not known to the compiler
+
+static void bench_memory( void )
+{
+	const uint8_t *src = (const uint8_t *) FLASH_BASE;
+	uint64_t       start;
+	unsigned       i;
+
+	start = bench_start();
+	for (i = 0; i < BENCH_LOOPS / 10; i++)
+		memcpy(bench_mem, src, bench_mem_size);
+	bench_print("memcpy", start, BENCH_LOOPS / 10);
+
+	start = bench_start();
+	for (i = 0; i < BENCH_LOOPS / 10; i++)
+		memcpy(bench_mem + 1, src + 2, bench_mem_size);
+	bench_print("memcpyu", start, BENCH_LOOPS / 10);
+
+	start = bench_start();
+	for (i = 0; i < BENCH_LOOPS / 10; i++)
+		memmove(bench_mem + 4, bench_mem, bench_mem_size);
+	bench_print("memmove", start, BENCH_LOOPS / 10);
+
+	start = bench_start();
+	for (i = 0; i < BENCH_LOOPS / 10; i++)
+		memset(bench_mem, (int) i, bench_mem_size);
+	bench_print("memset", start, BENCH_LOOPS / 10);
+}
+
+/******************************************************************************/
+
+void bench_run( void )
+{
+	uint64_t start;
+	unsigned i;
+
+	tsk_start(bench_task);
+
+	/* semaphore give and take, no context switch */
+	start = bench_start();
+	for (i = 0; i < BENCH_LOOPS; i++)
+	{
+		sem_give(bench_pong);
+		sem_take(bench_pong);
+	}
+	bench_print("sem", start, BENCH_LOOPS);
+
+	/* round trip to the partner task: two context switches */
+	start = bench_start();
+	for (i = 0; i < BENCH_LOOPS; i++)
+	{
+		sem_give(bench_ping);
+		sem_wait(bench_pong);
+	}
+	bench_print("switch", start, BENCH_LOOPS);
+
+#ifdef USE_HSM
+	bench_machine();
+#endif
+	bench_memory();
+	bench_typed();
+
+#ifdef USE_PACKET
+	bench_packet();
+#endif
+#ifdef USE_CEILING
+	bench_ceiling();
+#endif
+
+#ifdef USE_CRC
+	bench_crc();
+#endif
+#ifdef USE_ADC
+	bench_adc();
+#endif
+
+#ifndef USE_PGO
+	semihost_exit(0);
+#endif
+}
+
+/******************************************************************************/
+
+#endif//USE_BENCH
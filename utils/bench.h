@@ -0,0 +1,86 @@
+/*******************************************************************************
+@file     bench.h
+@author   agent
+@date     18.10.2026
+@brief    Kernel benchmark application (tools/matrix.py).
+          Enabled with USE_BENCH in DEFS; the results are printed through
+          semihosting, one line per test: "bench <name> <cycles per operation>",
+          then the program exits (the emulation is terminated); with USE_PGO
+          bench_run returns, the benchmark is the training run (make pgo BENCH=1).
+          The time is measured in cpu cycles over BENCH_LOOPS operations,
+          with the system tick counter and the SysTick down-counter (Cortex-M0
+          has no DWT cycle counter); under qemu with -icount it is proportional
+          to the number of executed instructions, so the results are reproducible.
+          The output goes through the semihosting of the library, or of
+          semihost.h with microlib (retargeted fputc).
+          On the linux host simulator (make -f makefile.host BENCH=1) the
+          output goes to stdout and the process exits; SysTick is plain
+          memory there, so the figures are system ticks, not cycles: the
+          host run is timed as a whole (make simspeed -f makefile.gnucc).
+          With USE_HSM (added by BENCH=1 and tools/matrix.py) an event of the
+          state machine is dispatched at once and through its queue:
+          "bench hsm", "bench hsmq".
+          With USE_ADC the acquisition throughput is measured on the board
+          (BENCH_TIME per rate): "bench adc<kS/s> <samples per second>",
+          "bench adc<kS/s>_load <cpu load in 0.01%>" and "..._lost <overruns>".
+          With USE_PACKET a message of 64 and 256 bytes is passed through
+          a mailbox queue (copied) and a packet channel (by reference):
+          "bench box<bytes>", "bench pkt<bytes>".
+          With USE_CEILING the kernel mutex and the ceiling mutex are locked
+          and unlocked without and with a contending task: "bench mtx",
+          "bench cmx", "bench mtx_cont", "bench cmx_cont".
+          The C++ templates of typed.hpp are compared with the C calls they
+          wrap (bench_typed.cpp): "bench box_c", "bench box_cpp", "bench mem_c",
+          "bench mem_cpp".
+*******************************************************************************/
+
+#pragma once
+
+#include <os.h>
+
+/*******************************************************************************
+ Configuration
+*******************************************************************************/
+
+#ifndef   BENCH_LOOPS
+#define   BENCH_LOOPS       10000 // <- number of operations of each test
+#endif
+#ifndef   BENCH_PRIO
+#define   BENCH_PRIO            2 // <- priority of the partner task, above the main task
+#endif
+#ifndef   BENCH_MEM
+#define   BENCH_MEM           512 // <- size of the block of the memory tests in bytes
+#endif
+#ifndef   BENCH_TIME
+#define   BENCH_TIME   (SEC / 10) // <- duration of each throughput test
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*******************************************************************************
+ Run the tests and exit (return with USE_PGO); called from the main task
+*******************************************************************************/
+
+void      bench_run( void );
+
+/*******************************************************************************
+ Helpers of the tests: cpu cycles from the start of the system,
+ and the cycles per operation of 'loops' operations since 'start' printed
+*******************************************************************************/
+
+uint64_t  bench_start( void );
+void      bench_print( const char *name, uint64_t start, unsigned loops );
+
+/*******************************************************************************
+ C++ templates (typed.hpp) against the C calls; bench_typed.cpp
+*******************************************************************************/
+
+void      bench_typed( void );
+
+#ifdef __cplusplus
+}
+#endif
+
+/******************************************************************************/
@@ -0,0 +1,96 @@
+/*******************************************************************************
+@file     bench_typed.cpp
+@author   agent
+@date     19.10.2026
+@brief    Kernel benchmark: the C++ templates (typed.hpp) against the C calls.
+          Built only with USE_BENCH (the makefiles leave it out otherwise,
+          a C++ source switches the whole build to the C++ runtime).
+*******************************************************************************/
+
+#ifdef USE_BENCH
+
+#include "bench.h"
+#include "typed.hpp"
+
+namespace {
+
+struct bench_msg_t
+{
+	uint32_t data[4];
+};
+
+/* -------------------------------------------------------------------------- */
+/* message queue: copy in and out, no context switch */
+
+void bench_queue( void )
+{
+	bench_msg_t msg = {};
+	bench_msg_t data[2];
+	box_t       box[1];
+	uint64_t    start;
+	unsigned    i;
+
+	typed::QueueT<bench_msg_t, 2> queue;
+
+	box_init(box, sizeof(bench_msg_t), data, sizeof(data));
+	start = bench_start();
+	for (i = 0; i < BENCH_LOOPS; i++)
+	{
+		box_sendFor(box, &msg, IMMEDIATE);
+		box_waitFor(box, &msg, IMMEDIATE);
+	}
+	bench_print("box_c", start, BENCH_LOOPS);
+
+	start = bench_start();
+	for (i = 0; i < BENCH_LOOPS; i++)
+	{
+		queue.give(msg);
+		queue.take(msg);
+	}
+	bench_print("box_cpp", start, BENCH_LOOPS);
+}
+
+/* -------------------------------------------------------------------------- */
+/* memory pool: take and give back an element */
+
+void bench_pool( void )
+{
+	que_t       data[2 * MEM_SIZE(sizeof(bench_msg_t))];
+	mem_t       mem[1];
+	void       *ptr;
+	uint64_t    start;
+	unsigned    i;
+
+	typed::PoolT<bench_msg_t, 2> pool;
+
+	mem_init(mem, sizeof(bench_msg_t), data, sizeof(data));
+	start = bench_start();
+	for (i = 0; i < BENCH_LOOPS; i++)
+	{
+		mem_waitFor(mem, &ptr, IMMEDIATE);
+		mem_give(mem, ptr);
+	}
+	bench_print("mem_c", start, BENCH_LOOPS);
+
+	start = bench_start();
+	for (i = 0; i < BENCH_LOOPS; i++)
+	{
+		bench_msg_t *msg = pool.take();
+		pool.give(msg);
+	}
+	bench_print("mem_cpp", start, BENCH_LOOPS);
+}
+
+}	// namespace
+
+/******************************************************************************/
+
+void bench_typed( void )
+{
+	bench_queue();
+	bench_pool();
+}
+
+/******************************************************************************/
+
+#endif//USE_BENCH
@@ -0,0 +1,111 @@
+/*******************************************************************************
+@file     ceiling.c
+@author   agent
+@date     18.10.2026
+@brief    Priority-ceiling mutex (immediate ceiling protocol).
+*******************************************************************************/
+
+#ifdef USE_CEILING
+
+#include "ceiling.h"
+
+/******************************************************************************/
+
+void cmx_init( cmx_t *cmx, unsigned ceiling )
+{
+	cmx->owner   = NULL;
+	cmx->ceiling = ceiling;
+	cmx->prio    = 0;
+	cmx->waiters = 0;
+	sem_init(&cmx->sem, 0, semBinary);
+}
+
+/******************************************************************************/
+
+unsigned cmx_waitFor( cmx_t *cmx, cnt_t delay )
+{
+	tsk_t   *cur  = tsk_this();
+	unsigned prio = tsk_getPrio();
+	unsigned event;
+	cnt_t    time = 0;
+
+	if (cmx->owner == cur)
+		return E_FAILURE;
+
+	if (prio < cmx->ceiling)
+		tsk_prio(cmx->ceiling);
+
+	if (delay != INFINITE && delay != IMMEDIATE)
+		time = sys_time() + delay;
+
+	for (;;)
+	{
+		/* fast path; the critical section covers the round-robin switch
+		   between the tasks of the ceiling priority */
+		sys_lock();
+		{
+			if (cmx->owner == NULL)
+			{
+				cmx->owner = cur;
+				cmx->prio  = prio;
+				event = E_SUCCESS;
+			}
+			else
+			{
+				cmx->waiters++;
+				event = E_TIMEOUT;
+			}
+		}
+		sys_unlock();
+
+		if (event == E_SUCCESS)
+			return E_SUCCESS;
+
+		/* slow path: the owner is blocked; the semaphore is given at every
+		   unlock with waiters, the woken task competes for the mutex again */
+		event = delay == IMMEDIATE ? E_TIMEOUT :
+		        delay == INFINITE  ? sem_wait(&cmx->sem) : sem_waitUntil(&cmx->sem, time);
+
+		sys_lock();
+		cmx->waiters--;
+		sys_unlock();
+
+		if (event != E_SUCCESS)
+			break;
+	}
+
+	if (prio < cmx->ceiling)
+		tsk_prio(prio);
+
+	return event;
+}
+
+/******************************************************************************/
+
+unsigned cmx_give( cmx_t *cmx )
+{
+	unsigned prio = cmx->prio;
+	bool     wake;
+
+	if (cmx->owner != tsk_this())
+		return E_FAILURE;
+
+	sys_lock();
+	{
+		cmx->owner = NULL;
+		wake = cmx->waiters > 0;
+	}
+	sys_unlock();
+
+	if (wake)
+		sem_give(&cmx->sem);
+
+	if (prio != tsk_getPrio())
+		tsk_prio(prio);
+
+	return E_SUCCESS;
+}
+
+/******************************************************************************/
+
+#endif//USE_CEILING
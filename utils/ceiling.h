@@ -0,0 +1,83 @@
+/*******************************************************************************
+@file     ceiling.h
+@author   agent
+@date     18.10.2026
+@brief    Priority-ceiling mutex (immediate ceiling protocol).
+          Enabled with USE_CEILING in DEFS.
+          The locking task is raised at once to the ceiling priority: the
+          highest priority of the tasks that use the mutex. No other user of
+          the mutex can preempt the owner, so the mutex is normally free
+          when it is taken: the lock is a check and a store in a short
+          critical section, no owner chains are walked and no task is queued.
+          Raising the priority of the running task never switches the context;
+          lowering it at the unlock switches only if a higher priority task
+          became ready in the meantime.
+          Only if the owner blocks while holding the mutex, the other users
+          wait on a semaphore (the slow path).
+*******************************************************************************/
+
+#pragma once
+
+#include <os.h>
+
+/*******************************************************************************
+ Mutex
+*******************************************************************************/
+
+typedef struct __cmx
+{
+	tsk_t   * volatile owner;
+	unsigned  ceiling;  // highest priority of the users of the mutex
+	unsigned  prio;     // priority of the owner before the lock
+	unsigned  waiters;  // number of tasks on the slow path
+	sem_t     sem;
+
+}	cmx_t;
+
+#define  _CMX_INIT(ceiling) \
+	{ NULL, (ceiling), 0, 0, _SEM_INIT(0, semBinary) }
+
+#define   OS_CMX(cmx, ceiling) \
+	cmx_t cmx[1] = { _CMX_INIT(ceiling) }
+
+#define   static_CMX(cmx, ceiling) \
+	static cmx_t cmx[1] = { _CMX_INIT(ceiling) }
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*******************************************************************************
+ Initialize the mutex; 'ceiling' must not be lower than the priority of any
+ task using the mutex
+*******************************************************************************/
+
+void      cmx_init( cmx_t *cmx, unsigned ceiling );
+
+/*******************************************************************************
+ Lock the mutex, wait up to 'delay' if it is held by a blocked owner;
+ not recursive, for tasks only; nested mutexes must be released in the
+ reverse order
+ return: E_SUCCESS, E_TIMEOUT, E_FAILURE (the mutex is already held by the task)
+*******************************************************************************/
+
+unsigned  cmx_waitFor( cmx_t *cmx, cnt_t delay );
+
+__STATIC_INLINE
+unsigned  cmx_wait( cmx_t *cmx ) { return cmx_waitFor(cmx, INFINITE); }
+
+__STATIC_INLINE
+unsigned  cmx_take( cmx_t *cmx ) { return cmx_waitFor(cmx, IMMEDIATE); }
+
+/*******************************************************************************
+ Unlock the mutex and restore the priority of the task
+ return: E_SUCCESS, E_FAILURE (the mutex is not held by the task)
+*******************************************************************************/
+
+unsigned  cmx_give( cmx_t *cmx );
+
+#ifdef __cplusplus
+}
+#endif
+
+/******************************************************************************/
@@ -0,0 +1,404 @@
+/*******************************************************************************
+@file     coro.hpp
+@author   agent
+@date     18.10.2026
+@brief    Stackless C++20 coroutine tasks on a static frame arena.
+          Enabled with USE_CORO in DEFS (-std=gnu++20, see makefile.gnucc).
+          A sequence is a coroutine returning coro::Task; it can co_await
+          a delay, a semaphore or a mailbox queue of the kernel. All the
+          sequences are resumed by one dispatcher task and hold no stack
+          while suspended: the RAM of a sequence is its frame (the local
+          variables that live across co_await and a few pointers), instead
+          of the task control block and the stack of a dedicated task.
+          The frames are allocated from a fixed arena (CORO_ARENA bytes),
+          a released frame is reused by a frame of the same size (the same
+          coroutine started again); never the heap.
+          The kernel objects do not notify the dispatcher: a waiting
+          sequence tries to take its object when the dispatcher is woken by
+          coro::notify(), called by coro::give() after sem_give / box_give,
+          and at its timeout. The dispatcher sleeps in the kernel between
+          the events, without a periodic tick. CORO_POLL (ticks, 0: off)
+          adds polling for the objects given without coro::notify().
+          Starvation: the kernel hands a semaphore or a message directly to
+          a task blocked on the object (sem_wait, box_wait), never to a
+          sequence; an object awaited by sequences must not be awaited by
+          tasks as well. With the object reserved to sequences, the waiting
+          sequences take it in the order they were suspended (a resumed
+          sequence waits again at the end of the list), so each of them is
+          served within one round of the dispatcher per give.
+          RAM of a frame with 32-bit pointers and cnt_t (as on Cortex-M0):
+          72 bytes for a delay loop, 112 bytes for a loop awaiting
+          a semaphore and a queue (GCC 12 -O2).
+          GCC 12 does not release the frame of a sequence destroyed before it
+          is started if a co_await is a part of a condition; assign the result
+          first: unsigned event = co_await coro::wait(sem); if (event ...)
+          Header-only; -fno-exceptions: an unhandled error stops the sequence.
+*******************************************************************************/
+
+#pragma once
+
+#include <os.h>
+#include <coroutine>
+#include <new>
+#include "typed.hpp"
+
+/*******************************************************************************
+ Configuration
+*******************************************************************************/
+
+#ifndef   CORO_ARENA
+#define   CORO_ARENA        1024  // <- size of the frame arena in bytes
+#endif
+#ifndef   CORO_PRIO
+#define   CORO_PRIO            1  // <- priority of the dispatcher task
+#endif
+#ifndef   CORO_STACK
+#define   CORO_STACK OS_STACK_SIZE // <- stack size of the dispatcher task
+#endif
+#ifndef   CORO_POLL
+#define   CORO_POLL            0  // <- polling period of the kernel objects in ticks, 0: no polling
+#endif
+
+namespace coro {
+
+/*******************************************************************************
+ Frame arena
+*******************************************************************************/
+
+struct Free
+{
+	Free   *next;
+	size_t  size;
+};
+
+alignas(8)
+inline unsigned char arena[CORO_ARENA];
+inline unsigned char *arena_next = arena;
+inline Free          *arena_free = nullptr;
+inline size_t         arena_used = 0;
+
+inline void *alloc( size_t size ) noexcept
+{
+	void *ptr = nullptr;
+
+	size = (size + 7) & ~size_t(7);
+	sys_lock();
+	{
+		for (Free **f = &arena_free; *f; f = &(*f)->next)
+		{
+			if ((*f)->size == size)
+			{
+				ptr = *f;
+				*f = (*f)->next;
+				break;
+			}
+		}
+		if (ptr == nullptr && size_t(arena + sizeof(arena) - arena_next) >= size)
+		{
+			ptr = arena_next;
+			arena_next += size;
+		}
+		if (ptr != nullptr)
+			arena_used += size;
+	}
+	sys_unlock();
+
+	return ptr;
+}
+
+inline void release( void *ptr, size_t size ) noexcept
+{
+	Free *f = static_cast<Free *>(ptr);
+
+	size = (size + 7) & ~size_t(7);
+	sys_lock();
+	{
+		f->size = size;
+		f->next = arena_free;
+		arena_free = f;
+		arena_used -= size;
+	}
+	sys_unlock();
+}
+
+/*******************************************************************************
+ Bytes of the arena used by the frames of the existing sequences
+*******************************************************************************/
+
+inline size_t used( void ) { return arena_used; }
+
+/*******************************************************************************
+ Waiting sequence, part of the frame (the awaiter or the promise)
+*******************************************************************************/
+
+struct Wait
+{
+	Wait                   *next;
+	std::coroutine_handle<> handle;
+	bool                  (*poll)( Wait * ); // try to take the kernel object, nullptr: delay only
+	cnt_t                   start;
+	cnt_t                   delay;           // timeout, INFINITE: none
+	unsigned                event;
+};
+
+inline Wait  *ready      = nullptr; // started sequences, in the order of coro::start
+inline Wait **ready_tail = &ready;
+inline Wait  *waiting    = nullptr; // suspended sequences, touched by the dispatcher only
+inline Wait **waiting_tail = &waiting;
+
+inline sem_t  event[1] = { _SEM_INIT(0, semBinary) };
+
+/*******************************************************************************
+ Wake the dispatcher to check the waiting sequences at once;
+ may be called from interrupt handlers
+*******************************************************************************/
+
+inline void notify( void ) { sem_giveISR(event); }
+
+/*******************************************************************************
+ Give the kernel object awaited by the sequences and wake the dispatcher;
+ may be called from interrupt handlers
+ return: the result of sem_give / box_give
+*******************************************************************************/
+
+inline unsigned give( sem_t *sem )
+{
+	unsigned result = sem_giveISR(sem);
+	notify();
+	return result;
+}
+
+inline unsigned give( box_t *box, const void *data )
+{
+	unsigned result = box_giveISR(box, data);
+	notify();
+	return result;
+}
+
+template<class T, unsigned Limit>
+inline unsigned give( typed::QueueT<T, Limit> &queue, const T &msg ) { return give(&queue, &msg); }
+
+/* -------------------------------------------------------------------------- */
+
+inline void suspend( Wait *w, std::coroutine_handle<> h )
+{
+	w->next   = nullptr;
+	w->handle = h;
+	w->start  = sys_time();
+	*waiting_tail = w;
+	waiting_tail = &w->next;
+}
+
+/* -------------------------------------------------------------------------- */
+
+inline void dispatcher( void )
+{
+	for (;;)
+	{
+		Wait *w, *next;
+		cnt_t now, left, timeout;
+
+		/* newly started sequences */
+		sys_lock();
+		{
+			w = ready;
+			ready = nullptr;
+			ready_tail = &ready;
+		}
+		sys_unlock();
+
+		for (; w; w = next)
+		{
+			next = w->next;
+			w->handle.resume();
+		}
+
+		/* waiting sequences; a resumed sequence may be suspended again
+		   and is then checked in the next round */
+		w = waiting;
+		waiting = nullptr;
+		waiting_tail = &waiting;
+		now = sys_time();
+
+		for (; w; w = next)
+		{
+			next = w->next;
+			if (w->poll != nullptr && w->poll(w))
+			{
+				w->event = E_SUCCESS;
+				w->handle.resume();
+			}
+			else
+			if (w->delay != INFINITE && now - w->start >= w->delay)
+			{
+				w->event = w->poll != nullptr ? E_TIMEOUT : E_SUCCESS;
+				w->handle.resume();
+			}
+			else
+			{
+				w->next = nullptr;
+				*waiting_tail = w;
+				waiting_tail = &w->next;
+			}
+		}
+
+		/* time to the nearest deadline or poll */
+		timeout = ready != nullptr ? IMMEDIATE : INFINITE;
+		now = sys_time();
+		for (w = waiting; w; w = w->next)
+		{
+			if (CORO_POLL > 0 && w->poll != nullptr && timeout > CORO_POLL)
+				timeout = CORO_POLL;
+			if (w->delay != INFINITE)
+			{
+				left = now - w->start >= w->delay ? 0 : w->start + w->delay - now;
+				if (timeout > left)
+					timeout = left;
+			}
+		}
+
+		if (timeout != IMMEDIATE)
+			sem_waitFor(event, timeout);
+	}
+}
+
+/* the dispatcher task is constructed by the first coro::start, not by the
+   static initialization (the kernel may not be ready yet) */
+
+using Dispatcher = typed::TaskT<CORO_STACK>;
+
+alignas(Dispatcher)
+inline unsigned char dispatcher_task[sizeof(Dispatcher)];
+inline bool          dispatcher_started = false;
+
+/*******************************************************************************
+ Sequence: a coroutine returning coro::Task
+ coro::Task blink() { for (;;) { led_toggle(); co_await coro::delay(SEC/2); } }
+ coro::start(blink());
+*******************************************************************************/
+
+struct Task
+{
+	struct promise_type
+	{
+		Wait node;
+
+		Task                get_return_object( void ) noexcept { return Task(std::coroutine_handle<promise_type>::from_promise(*this)); }
+		static Task         get_return_object_on_allocation_failure( void ) noexcept { return Task(); }
+		std::suspend_always initial_suspend( void ) noexcept { return {}; }
+		std::suspend_never  final_suspend( void ) noexcept { return {}; }
+		void                return_void( void ) noexcept {}
+		void                unhandled_exception( void ) noexcept {}
+
+		static void        *operator new( size_t size ) noexcept { return alloc(size); }
+		static void         operator delete( void *ptr, size_t size ) noexcept { release(ptr, size); }
+	};
+
+	Task( void ) = default;
+	explicit
+	Task( std::coroutine_handle<promise_type> h ) : handle(h) {}
+	Task( Task &&t ) noexcept : handle(t.handle) { t.handle = nullptr; }
+	~Task( void ) { if (handle) handle.destroy(); } // never started: release the frame
+
+	Task &operator=( Task &&t ) noexcept { if (this != &t) { if (handle) handle.destroy(); handle = t.handle; t.handle = nullptr; } return *this; }
+
+	Task( const Task & ) = delete;
+	Task &operator=( const Task & ) = delete;
+
+	explicit operator bool( void ) const { return bool(handle); }
+
+	std::coroutine_handle<promise_type> handle;
+};
+
+/*******************************************************************************
+ Pass the sequence to the dispatcher (constructed and started at the first call)
+ coro::start(blink()), coro::start(std::move(task))
+ return: E_SUCCESS, E_FAILURE (the arena is full)
+*******************************************************************************/
+
+inline unsigned start( Task task )
+{
+	bool run;
+
+	if (!task)
+		return E_FAILURE;
+
+	/* the dispatcher owns the frame now, released at the end of the sequence */
+	Wait *w = &task.handle.promise().node;
+	w->next   = nullptr;
+	w->handle = task.handle;
+	task.handle = nullptr;
+
+	sys_lock();
+	{
+		*ready_tail = w;
+		ready_tail = &w->next;
+		run = !dispatcher_started;
+		dispatcher_started = true;
+	}
+	sys_unlock();
+
+	if (run)
+		(new (dispatcher_task) Dispatcher(CORO_PRIO, dispatcher))->start();
+	else
+		notify();
+
+	return E_SUCCESS;
+}
+
+/*******************************************************************************
+ co_await coro::delay(time)
+*******************************************************************************/
+
+struct Delay : Wait
+{
+	bool     await_ready  ( void ) { return delay == IMMEDIATE; }
+	void     await_suspend( std::coroutine_handle<> h ) { suspend(this, h); }
+	void     await_resume ( void ) {}
+};
+
+inline Delay delay( cnt_t time ) { return Delay { { nullptr, nullptr, nullptr, 0, time, 0 } }; }
+
+/*******************************************************************************
+ co_await coro::wait(sem [, timeout])
+ return: E_SUCCESS, E_TIMEOUT
+*******************************************************************************/
+
+struct SemWait : Wait
+{
+	sem_t   *sem;
+
+	static bool take( Wait *w ) { return sem_take(static_cast<SemWait *>(w)->sem) == E_SUCCESS; }
+
+	bool     await_ready  ( void ) { event = take(this) ? E_SUCCESS : E_TIMEOUT; return event == E_SUCCESS || delay == IMMEDIATE; }
+	void     await_suspend( std::coroutine_handle<> h ) { suspend(this, h); }
+	unsigned await_resume ( void ) { return event; }
+};
+
+inline SemWait wait( sem_t *sem, cnt_t timeout = INFINITE ) { return SemWait { { nullptr, nullptr, SemWait::take, 0, timeout, 0 }, sem }; }
+
+/*******************************************************************************
+ co_await coro::wait(box, data [, timeout]), co_await coro::wait(queue, msg [, timeout])
+ return: E_SUCCESS, E_TIMEOUT
+*******************************************************************************/
+
+struct BoxWait : Wait
+{
+	box_t   *box;
+	void    *data;
+
+	static bool take( Wait *w ) { BoxWait *b = static_cast<BoxWait *>(w); return box_take(b->box, b->data) == E_SUCCESS; }
+
+	bool     await_ready  ( void ) { event = take(this) ? E_SUCCESS : E_TIMEOUT; return event == E_SUCCESS || delay == IMMEDIATE; }
+	void     await_suspend( std::coroutine_handle<> h ) { suspend(this, h); }
+	unsigned await_resume ( void ) { return event; }
+};
+
+inline BoxWait wait( box_t *box, void *data, cnt_t timeout = INFINITE ) { return BoxWait { { nullptr, nullptr, BoxWait::take, 0, timeout, 0 }, box, data }; }
+
+template<class T, unsigned Limit>
+inline BoxWait wait( typed::QueueT<T, Limit> &queue, T &msg, cnt_t timeout = INFINITE ) { return wait(&queue, &msg, timeout); }
+
+}	// namespace coro
+
+/******************************************************************************/
@@ -0,0 +1,240 @@
+/*******************************************************************************
+@file     cpuload.c
+@author   agent
+@date     18.10.2026
+@brief    Per-task cpu load accounting for STM32F0xx.
+*******************************************************************************/
+
+#ifdef USE_CPU_LOAD
+
+#include "cpuload.h"
+#include <string.h>
+
+/*******************************************************************************
+ Specific definitions for the compiler
+ the kernel context switch handler is hooked at link time:
+ gnucc with '--wrap' (see makefile.gnucc), armcc / clang with $Sub$$ / $Super$$
+*******************************************************************************/
+
+#if   defined(__ICCARM__)
+#error    USE_CPU_LOAD is not supported by the IAR toolchain
+#elif defined(__ARMCC_VERSION)
+#define   CPU_HOOK  $Sub$$core_tsk_handler
+#define   CPU_REAL  $Super$$core_tsk_handler
+#else
+#define   CPU_HOOK  __wrap_core_tsk_handler
+#define   CPU_REAL  __real_core_tsk_handler
+#endif
+
+#if      !defined(TIM2)
+#error    USE_CPU_LOAD requires the 32-bit TIM2 timer
+#endif
+
+/*******************************************************************************
+ Accounts
+*******************************************************************************/
+
+#define   CPU_PERIOD ((uint32_t)CPU_LOAD_PERIOD * (CPU_FREQUENCY / 1000))
+
+#define   ACC_ISR    0
+#define   ACC_IDLE   1
+#define   ACC_OTHER  2
+#define   ACC_TASK   3
+#define   ACC_COUNT (ACC_TASK + CPU_LOAD_TASKS)
+
+static struct
+{
+	tsk_t   * tsk[CPU_LOAD_TASKS];              // owners of the task accounts
+	uint32_t  acc[ACC_COUNT];                   // current period
+	uint32_t  sum[ACC_COUNT];                   // sliding window
+	uint32_t  hst[CPU_LOAD_SLOTS][ACC_COUNT];   // history of the periods
+	uint32_t  mark;                             // time of the last accounting
+	uint32_t  start;                            // start of the current period
+	unsigned  slot;                             // the oldest period in history
+	unsigned  task;                             // account of the current task
+	unsigned  cur;                              // account being charged
+	unsigned  nest;                             // interrupt nesting level
+
+}	cpu;
+
+/* -------------------------------------------------------------------------- */
+
+static
+void cpu_roll( uint32_t now )
+{
+	uint32_t *hst = cpu.hst[cpu.slot];
+	unsigned  i;
+
+	for (i = 0; i < ACC_COUNT; i++)
+	{
+		cpu.sum[i] += cpu.acc[i] - hst[i];
+		hst[i] = cpu.acc[i];
+		cpu.acc[i] = 0;
+	}
+
+	if (++cpu.slot == CPU_LOAD_SLOTS)
+		cpu.slot = 0;
+
+	cpu.start = now;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/* the time since the last accounting is split at the period boundaries; after
+   CPU_LOAD_SLOTS elapsed periods the whole window belongs to the current account
+   and the remaining periods are skipped */
+
+static
+void cpu_charge( uint32_t now )
+{
+	unsigned n;
+
+	for (n = 0; now - cpu.start >= CPU_PERIOD; n++)
+	{
+		if (n == CPU_LOAD_SLOTS)
+		{
+			cpu.start = cpu.mark = now - (now - cpu.start) % CPU_PERIOD;
+			break;
+		}
+
+		cpu.acc[cpu.cur] += cpu.start + CPU_PERIOD - cpu.mark;
+		cpu.mark = cpu.start + CPU_PERIOD;
+		cpu_roll(cpu.mark);
+	}
+
+	cpu.acc[cpu.cur] += now - cpu.mark;
+	cpu.mark = now;
+}
+
+/* -------------------------------------------------------------------------- */
+
+static
+unsigned cpu_account( tsk_t *tsk )
+{
+	unsigned i;
+
+	if (tsk == &IDLE)
+		return ACC_IDLE;
+
+	for (i = 0; i < CPU_LOAD_TASKS; i++)
+	{
+		if (cpu.tsk[i] == NULL)
+			cpu.tsk[i] = tsk;
+		if (cpu.tsk[i] == tsk)
+			return ACC_TASK + i;
+	}
+
+	return ACC_OTHER;
+}
+
+/*******************************************************************************
+ Context switch hook
+*******************************************************************************/
+
+void *CPU_REAL( void *sp );
+
+void *CPU_HOOK( void *sp )
+{
+	sp = CPU_REAL(sp);
+
+	sys_lockISR();
+	cpu_charge(cpu_cycles());
+	cpu.task = cpu_account(System.cur);
+	if (cpu.nest == 0)
+		cpu.cur = cpu.task;
+	sys_unlockISR();
+
+	return sp;
+}
+
+/******************************************************************************/
+
+void cpu_init( void )
+{
+	RCC->APB1ENR |= RCC_APB1ENR_TIM2EN;
+
+	TIM2->CR1 = 0;
+	TIM2->PSC = 0;
+	TIM2->ARR = 0xFFFFFFFF;
+	TIM2->EGR = TIM_EGR_UG;
+	TIM2->CR1 = TIM_CR1_CEN;
+
+	sys_lock();
+	memset(&cpu, 0, sizeof(cpu));
+	cpu.mark = cpu.start = cpu_cycles();
+	cpu.task = cpu.cur = cpu_account(System.cur);
+	sys_unlock();
+}
+
+/******************************************************************************/
+
+void cpu_isrEnter( void )
+{
+	sys_lockISR();
+	if (cpu.nest++ == 0)
+	{
+		cpu_charge(cpu_cycles());
+		cpu.cur = ACC_ISR;
+	}
+	sys_unlockISR();
+}
+
+/******************************************************************************/
+
+void cpu_isrLeave( void )
+{
+	sys_lockISR();
+	if (--cpu.nest == 0)
+	{
+		cpu_charge(cpu_cycles());
+		cpu.cur = cpu.task;
+	}
+	sys_unlockISR();
+}
+
+/******************************************************************************/
+
+static
+unsigned cpu_percent( uint32_t part, uint32_t total )
+{
+	return (unsigned)((uint64_t)part * 10000U / total);
+}
+
+void cpu_snapshot( cpu_load_t *load )
+{
+	uint32_t sum[ACC_COUNT];
+	tsk_t  * tsk[CPU_LOAD_TASKS];
+	uint32_t total = 0;
+	unsigned i;
+
+	sys_lock();
+	cpu_charge(cpu_cycles());
+	memcpy(sum, cpu.sum, sizeof(sum));
+	memcpy(tsk, cpu.tsk, sizeof(tsk));
+	sys_unlock();
+
+	memset(load, 0, sizeof(*load));
+
+	for (i = 0; i < ACC_COUNT; i++)
+		total += sum[i];
+
+	if (total == 0)
+		return;
+
+	load->isr   = cpu_percent(sum[ACC_ISR],   total);
+	load->idle  = cpu_percent(sum[ACC_IDLE],  total);
+	load->other = cpu_percent(sum[ACC_OTHER], total);
+	load->total = 10000U - load->idle;
+
+	for (i = 0; i < CPU_LOAD_TASKS && tsk[i] != NULL; i++)
+	{
+		load->task[i].tsk  = tsk[i];
+		load->task[i].load = cpu_percent(sum[ACC_TASK + i], total);
+	}
+
+	load->count = i;
+}
+
+/******************************************************************************/
+
+#endif//USE_CPU_LOAD
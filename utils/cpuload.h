@@ -0,0 +1,84 @@
+/*******************************************************************************
+@file     cpuload.h
+@author   agent
+@date     18.10.2026
+@brief    Per-task cpu load accounting for STM32F0xx.
+          Enabled with USE_CPU_LOAD in DEFS; uses TIM2 as a free-running
+          cycle counter and hooks the kernel context switch handler.
+*******************************************************************************/
+
+#pragma once
+
+#include <os.h>
+#include <stm32f0xx.h>
+
+/*******************************************************************************
+ Configuration
+*******************************************************************************/
+
+#ifndef   CPU_LOAD_TASKS
+#define   CPU_LOAD_TASKS     8    // <- number of accounted tasks (without idle)
+#endif
+#ifndef   CPU_LOAD_SLOTS
+#define   CPU_LOAD_SLOTS     4    // <- number of periods in the sliding window
+#endif
+#ifndef   CPU_LOAD_PERIOD
+#define   CPU_LOAD_PERIOD  250    // <- length of one period in milliseconds
+#endif
+
+/*******************************************************************************
+ Snapshot of the cpu load
+ all loads are given in hundredths of a percent (0..10000)
+*******************************************************************************/
+
+typedef struct __cpu_load
+{
+	unsigned  total;                // total cpu load (everything except idle)
+	unsigned  isr;                  // time spent in accounted interrupts
+	unsigned  idle;                 // time spent in the idle task
+	unsigned  other;                // tasks that did not fit in the table
+	unsigned  count;                // number of valid entries in 'task'
+	struct
+	{
+		tsk_t  *tsk;
+		unsigned load;
+	}         task[CPU_LOAD_TASKS];
+
+}	cpu_load_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*******************************************************************************
+ Start the cycle counter and reset all accumulators
+*******************************************************************************/
+
+void     cpu_init( void );
+
+/*******************************************************************************
+ Current value of the free-running cycle counter
+*******************************************************************************/
+
+__STATIC_FORCEINLINE
+uint32_t cpu_cycles( void ) { return TIM2->CNT; }
+
+/*******************************************************************************
+ Attribute the time of an interrupt handler to the 'isr' account;
+ call cpu_isrEnter at the beginning and cpu_isrLeave at the end of the handler
+*******************************************************************************/
+
+void     cpu_isrEnter( void );
+void     cpu_isrLeave( void );
+
+/*******************************************************************************
+ Take a snapshot of the cpu load over the last CPU_LOAD_SLOTS periods
+*******************************************************************************/
+
+void     cpu_snapshot( cpu_load_t *load );
+
+#ifdef __cplusplus
+}
+#endif
+
+/******************************************************************************/
@@ -0,0 +1,151 @@
+/*******************************************************************************
+@file     evgroup.c
+@author   agent
+@date     18.10.2026
+@brief    Event-flag groups with wait-any / wait-all conditions.
+*******************************************************************************/
+
+#ifdef USE_EVGROUP
+
+#include "evgroup.h"
+
+/* -------------------------------------------------------------------------- */
+/* return the flags satisfying the condition or 0; called in a critical section */
+
+static
+unsigned evg_match( evg_t *evg, unsigned flags, unsigned mode )
+{
+	unsigned found = evg->flags & flags;
+
+	if (mode & evgAll ? found != flags : found == 0)
+		return 0;
+
+	if (mode & evgClear)
+		evg->flags &= ~found;
+
+	return found;
+}
+
+/******************************************************************************/
+
+void evg_init( evg_t *evg, unsigned init )
+{
+	evg->flags = init;
+	evg->queue = NULL;
+}
+
+/******************************************************************************/
+
+unsigned evg_waitFor( evg_t *evg, unsigned flags, unsigned mode, unsigned *result, cnt_t delay )
+{
+	evg_wait_t   wait;
+	evg_wait_t **ptr;
+	unsigned     event = E_SUCCESS;
+	bool         block = false;
+
+	wait.next   = NULL;
+	wait.flags  = flags;
+	wait.mode   = mode;
+	wait.result = 0;
+	sem_init(&wait.sem, 0, semBinary);
+
+	sys_lock();
+	{
+		wait.result = evg_match(evg, flags, mode);
+		if (wait.result == 0)
+		{
+			if (delay == IMMEDIATE)
+			{
+				event = E_TIMEOUT;
+			}
+			else
+			{
+				for (ptr = &evg->queue; *ptr; ptr = &(*ptr)->next);
+				*ptr = &wait;
+				block = true;
+			}
+		}
+	}
+	sys_unlock();
+
+	if (block)
+	{
+		sem_waitFor(&wait.sem, delay);
+
+		/* the record is removed from the queue by evg_give before the semaphore is given */
+		sys_lock();
+		{
+			for (ptr = &evg->queue; *ptr && *ptr != &wait; ptr = &(*ptr)->next);
+			if (*ptr)
+			{
+				*ptr = wait.next;
+				event = E_TIMEOUT;
+			}
+			else
+			{
+				event = E_SUCCESS;
+			}
+		}
+		sys_unlock();
+	}
+
+	if (result)
+		*result = wait.result;
+
+	return event;
+}
+
+/******************************************************************************/
+
+unsigned evg_give( evg_t *evg, unsigned flags )
+{
+	evg_wait_t **ptr;
+	evg_wait_t  *wait;
+	unsigned     state;
+
+	sys_lock();
+	{
+		evg->flags |= flags;
+
+		/* one pass over the queue; the tasks are made ready inside the
+		   critical section, the context is switched once after it */
+		for (ptr = &evg->queue; (wait = *ptr) != NULL; )
+		{
+			wait->result = evg_match(evg, wait->flags, wait->mode);
+			if (wait->result)
+			{
+				*ptr = wait->next;
+				sem_giveISR(&wait->sem);
+			}
+			else
+			{
+				ptr = &wait->next;
+			}
+		}
+
+		state = evg->flags;
+	}
+	sys_unlock();
+
+	return state;
+}
+
+/******************************************************************************/
+
+unsigned evg_clear( evg_t *evg, unsigned flags )
+{
+	unsigned state;
+
+	sys_lock();
+	{
+		state = evg->flags;
+		evg->flags &= ~flags;
+	}
+	sys_unlock();
+
+	return state;
+}
+
+/******************************************************************************/
+
+#endif//USE_EVGROUP
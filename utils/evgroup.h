@@ -0,0 +1,112 @@
+/*******************************************************************************
+@file     evgroup.h
+@author   agent
+@date     18.10.2026
+@brief    Event-flag groups with wait-any / wait-all conditions.
+          Enabled with USE_EVGROUP in DEFS.
+          evg_give sets the flags and evaluates all waiting tasks in one pass
+          inside a single critical section: every task whose condition is
+          met is made ready, and the scheduler runs once at the end of the
+          section, so setting several conditions at once causes one context
+          switch (to the highest priority woken task) instead of a wakeup
+          storm. The time of evg_give is linear in the number of waiters.
+*******************************************************************************/
+
+#pragma once
+
+#include <os.h>
+
+/*******************************************************************************
+ Wait modes
+*******************************************************************************/
+
+#define   evgAny      0U // <- any of the flags
+#define   evgAll      1U // <- all of the flags
+#define   evgClear    2U // <- clear the awaited flags when the condition is met
+
+/*******************************************************************************
+ Waiter record, placed on the stack of the waiting task
+*******************************************************************************/
+
+typedef struct __evg_wait
+{
+	struct __evg_wait *next;
+	unsigned           flags;  // awaited flags
+	unsigned           mode;
+	unsigned           result; // flags that satisfied the condition
+	sem_t              sem;
+
+}	evg_wait_t;
+
+/*******************************************************************************
+ Event-flag group
+*******************************************************************************/
+
+typedef struct __evg
+{
+	volatile unsigned  flags;
+	evg_wait_t        *queue;  // waiting tasks in the order of arrival
+
+}	evg_t;
+
+#define  _EVG_INIT(init) \
+	{ (init), NULL }
+
+#define   OS_EVG(evg, init) \
+	evg_t evg[1] = { _EVG_INIT(init) }
+
+#define   static_EVG(evg, init) \
+	static evg_t evg[1] = { _EVG_INIT(init) }
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*******************************************************************************
+ Initialize the group with the flags 'init'
+*******************************************************************************/
+
+void      evg_init( evg_t *evg, unsigned init );
+
+/*******************************************************************************
+ Wait up to 'delay' for the flags; for tasks only, unless called with IMMEDIATE
+ mode:   evgAny or evgAll, optionally with evgClear
+ result: the flags that satisfied the condition (may be NULL)
+ return: E_SUCCESS, E_TIMEOUT
+*******************************************************************************/
+
+unsigned  evg_waitFor( evg_t *evg, unsigned flags, unsigned mode, unsigned *result, cnt_t delay );
+
+__STATIC_INLINE
+unsigned  evg_wait( evg_t *evg, unsigned flags, unsigned mode, unsigned *result ) { return evg_waitFor(evg, flags, mode, result, INFINITE); }
+
+__STATIC_INLINE
+unsigned  evg_take( evg_t *evg, unsigned flags, unsigned mode, unsigned *result ) { return evg_waitFor(evg, flags, mode, result, IMMEDIATE); }
+
+/*******************************************************************************
+ Set the flags and wake all the tasks whose conditions are met;
+ may be called from interrupt handlers
+ return: the flags of the group after the operation
+*******************************************************************************/
+
+unsigned  evg_give( evg_t *evg, unsigned flags );
+
+/*******************************************************************************
+ Clear the flags; may be called from interrupt handlers
+ return: the flags of the group before the operation
+*******************************************************************************/
+
+unsigned  evg_clear( evg_t *evg, unsigned flags );
+
+/*******************************************************************************
+ Current flags of the group
+*******************************************************************************/
+
+__STATIC_INLINE
+unsigned  evg_get( evg_t *evg ) { return evg->flags; }
+
+#ifdef __cplusplus
+}
+#endif
+
+/******************************************************************************/
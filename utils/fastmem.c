@@ -0,0 +1,219 @@
+/*******************************************************************************
+@file     fastmem.c
+@author   agent
+@date     18.10.2026
+@brief    memcpy, memmove and memset optimized for Cortex-M0.
+          Enabled with USE_FAST_MEM in DEFS; replaces the size-optimized
+          byte loops of the compiler libraries (newlib-nano, microlib).
+*******************************************************************************/
+
+#ifdef USE_FAST_MEM
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+/*******************************************************************************
+ Specific definitions for the compiler
+ the loops below must not be turned back into calls of the functions they implement
+*******************************************************************************/
+
+#if   defined(__clang__)
+#if   __has_attribute(no_builtin)
+#define   MEM_FUNC  __attribute__((no_builtin))
+#else
+#error    fastmem.c: the no_builtin attribute is required (clang 10 or later)!
+#endif
+#elif defined(__GNUC__)
+#define   MEM_FUNC  __attribute__((optimize("no-tree-loop-distribute-patterns")))
+#else
+#define   MEM_FUNC
+#endif
+
+#define   MEM_SMALL  8 // smaller blocks are copied by the jump table only
+
+/* -------------------------------------------------------------------------- */
+
+static inline
+void mem_tail( uint8_t *dst, const uint8_t *src, size_t size )
+{
+	/* ascending order, as required by memmove for the overlapping blocks */
+	dst += size;
+	src += size;
+
+	switch (size)
+	{
+	case 7: dst[-7] = src[-7]; /* fall through */
+	case 6: dst[-6] = src[-6]; /* fall through */
+	case 5: dst[-5] = src[-5]; /* fall through */
+	case 4: dst[-4] = src[-4]; /* fall through */
+	case 3: dst[-3] = src[-3]; /* fall through */
+	case 2: dst[-2] = src[-2]; /* fall through */
+	case 1: dst[-1] = src[-1]; /* fall through */
+	default: break;
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+/* copy 'count' words between word aligned buffers, 4 words (ldm / stm) at once */
+
+MEM_FUNC static
+void mem_words( uint32_t *dst, const uint32_t *src, size_t count )
+{
+	while (count >= 4)
+	{
+		uint32_t a = src[0], b = src[1], c = src[2], d = src[3];
+		dst[0] = a; dst[1] = b; dst[2] = c; dst[3] = d;
+		src += 4; dst += 4; count -= 4;
+	}
+
+	while (count--) *dst++ = *src++;
+}
+
+/* -------------------------------------------------------------------------- */
+/* copy 'count' words to the aligned 'dst' from the misaligned 'src' */
+
+MEM_FUNC static
+void mem_merge( uint32_t *dst, const uint8_t *src, size_t count )
+{
+	unsigned        off = (uintptr_t) src & 3U;
+	unsigned        shr = off * 8;
+	unsigned        shl = 32 - shr;
+	const uint32_t *ptr = (const uint32_t *)(src - off);
+	uint32_t        cur = *ptr++;
+
+	while (count--)
+	{
+		uint32_t nxt = *ptr++;
+		*dst++ = (cur >> shr) | (nxt << shl);
+		cur = nxt;
+	}
+}
+
+/******************************************************************************/
+
+MEM_FUNC
+void *memcpy( void *dst, const void *src, size_t size )
+{
+	uint8_t       *d = dst;
+	const uint8_t *s = src;
+	size_t         n;
+
+	if (size >= MEM_SMALL)
+	{
+		/* align the destination */
+		while ((uintptr_t) d & 3U)
+		{
+			*d++ = *s++;
+			size--;
+		}
+
+		n = size / 4;
+
+		if (((uintptr_t) s & 3U) == 0)
+			mem_words((uint32_t *) d, (const uint32_t *) s, n);
+		else
+			mem_merge((uint32_t *) d, s, n);
+
+		d += n * 4;
+		s += n * 4;
+		size &= 3U;
+	}
+
+	mem_tail(d, s, size);
+
+	return dst;
+}
+
+/******************************************************************************/
+
+MEM_FUNC
+void *memmove( void *dst, const void *src, size_t size )
+{
+	uint8_t       *d = dst;
+	const uint8_t *s = src;
+
+	if (d <= s || d >= s + size)
+		return memcpy(dst, src, size);
+
+	/* overlapping, destination above the source: copy backwards */
+	d += size;
+	s += size;
+
+	if ((((uintptr_t) d ^ (uintptr_t) s) & 3U) == 0 && size >= MEM_SMALL)
+	{
+		while ((uintptr_t) d & 3U)
+		{
+			*--d = *--s;
+			size--;
+		}
+
+		while (size >= 4)
+		{
+			d -= 4; s -= 4; size -= 4;
+			*(uint32_t *) d = *(const uint32_t *) s;
+		}
+	}
+
+	while (size--) *--d = *--s;
+
+	return dst;
+}
+
+/******************************************************************************/
+
+MEM_FUNC
+void *memset( void *dst, int c, size_t size )
+{
+	uint8_t  *d = dst;
+	uint32_t  w = (uint8_t) c * 0x01010101U;
+	uint32_t *p;
+
+	if (size >= MEM_SMALL)
+	{
+		while ((uintptr_t) d & 3U)
+		{
+			*d++ = (uint8_t) c;
+			size--;
+		}
+
+		for (p = (uint32_t *) d; size >= 16; size -= 16, p += 4)
+		{
+			p[0] = w; p[1] = w; p[2] = w; p[3] = w;
+		}
+
+		for (; size >= 4; size -= 4)
+			*p++ = w;
+
+		d = (uint8_t *) p;
+	}
+
+	while (size--) *d++ = (uint8_t) c;
+
+	return dst;
+}
+
+/*******************************************************************************
+ Run-time ABI entry points used by the ARM and IAR compilers
+*******************************************************************************/
+
+#if defined(__ARMCC_VERSION) || defined(__ICCARM__)
+
+void __aeabi_memcpy ( void *dst, const void *src, size_t size ) { memcpy (dst, src, size); }
+void __aeabi_memcpy4( void *dst, const void *src, size_t size ) { memcpy (dst, src, size); }
+void __aeabi_memcpy8( void *dst, const void *src, size_t size ) { memcpy (dst, src, size); }
+void __aeabi_memmove( void *dst, const void *src, size_t size ) { memmove(dst, src, size); }
+void __aeabi_memmove4(void *dst, const void *src, size_t size ) { memmove(dst, src, size); }
+void __aeabi_memmove8(void *dst, const void *src, size_t size ) { memmove(dst, src, size); }
+void __aeabi_memset ( void *dst, size_t size, int c )           { memset (dst, c, size);   }
+void __aeabi_memset4( void *dst, size_t size, int c )           { memset (dst, c, size);   }
+void __aeabi_memset8( void *dst, size_t size, int c )           { memset (dst, c, size);   }
+void __aeabi_memclr ( void *dst, size_t size )                  { memset (dst, 0, size);   }
+void __aeabi_memclr4( void *dst, size_t size )                  { memset (dst, 0, size);   }
+void __aeabi_memclr8( void *dst, size_t size )                  { memset (dst, 0, size);   }
+
+#endif
+
+/******************************************************************************/
+
+#endif//USE_FAST_MEM
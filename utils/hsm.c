@@ -0,0 +1,173 @@
+/*******************************************************************************
+@file     hsm.c
+@author   agent
+@date     18.10.2026
+@brief    Table-driven hierarchical state machines.
+*******************************************************************************/
+
+#ifdef USE_HSM
+
+#include "hsm.h"
+
+/* -------------------------------------------------------------------------- */
+
+static
+unsigned hsm_depth( const hsm_state_t *s )
+{
+	unsigned depth = 0;
+
+	for (; s; s = s->parent)
+		depth++;
+
+	return depth;
+}
+
+/* -------------------------------------------------------------------------- */
+/* enter the states from below 'top' down to 'dst', then the default substates of 'dst';
+   the callers check that 'dst' is nested at most HSM_DEPTH deep (the size of 'path') */
+
+static
+void hsm_enter( hsm_t *hsm, const hsm_state_t *top, const hsm_state_t *dst, const hsm_event_t *evt )
+{
+	const hsm_state_t *path[HSM_DEPTH];
+	const hsm_state_t *s;
+	unsigned           n = 0;
+
+	for (s = dst; s != top; s = s->parent)
+		path[n++] = s;
+
+	while (n > 0)
+	{
+		hsm->state = s = path[--n];
+		if (s->entry) s->entry(hsm, evt);
+	}
+
+	while (s->init)
+	{
+		hsm->state = s = s->init;
+		if (s->entry) s->entry(hsm, evt);
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+static
+const hsm_tran_t *hsm_find( const hsm_state_t *s, hsm_t *hsm, const hsm_event_t *evt )
+{
+	const hsm_tran_t *t;
+
+	if (s->tran)
+		for (t = s->tran; t->sig != hsmEnd; t++)
+			if (t->sig == evt->sig && (t->guard == NULL || t->guard(hsm, evt)))
+				return t;
+
+	return NULL;
+}
+
+/******************************************************************************/
+
+unsigned hsm_init( hsm_t *hsm, const hsm_state_t *init, hsm_event_t *data, unsigned bufsize )
+{
+	hsm_event_t evt = { hsmEnd, 0 };
+
+	box_init(&hsm->queue, sizeof(hsm_event_t), data, bufsize);
+	hsm->state = NULL;
+
+	if (hsm_depth(init) > HSM_DEPTH)
+		return E_FAILURE;
+
+	hsm_enter(hsm, NULL, init, &evt);
+
+	return E_SUCCESS;
+}
+
+/******************************************************************************/
+
+unsigned hsm_dispatch( hsm_t *hsm, const hsm_event_t *evt )
+{
+	const hsm_state_t *src, *dst, *lca, *s;
+	const hsm_tran_t  *t = NULL;
+	unsigned           ns, nd;
+
+	for (src = hsm->state; src; src = src->parent)
+		if ((t = hsm_find(src, hsm, evt)) != NULL)
+			break;
+
+	if (t == NULL)
+		return E_FAILURE;
+
+	dst = t->target;
+	if (dst == NULL)
+	{
+		if (t->action) t->action(hsm, evt);
+		return E_SUCCESS;
+	}
+
+	/* least common ancestor of the source and the target */
+	ns = hsm_depth(src);
+	nd = hsm_depth(dst);
+	if (nd > HSM_DEPTH)
+		return E_FAILURE;
+	for (lca = src; ns > nd; ns--) lca = lca->parent;
+	for (s   = dst; nd > ns; nd--) s   = s->parent;
+	while (lca != s) { lca = lca->parent; s = s->parent; }
+	/* external transition: the source or the target containing the other is exited */
+	if (lca == src || lca == dst)
+		lca = lca->parent;
+
+	for (s = hsm->state; s != lca; hsm->state = s = s->parent)
+		if (s->exit) s->exit(hsm, evt);
+
+	if (t->action) t->action(hsm, evt);
+
+	hsm_enter(hsm, lca, dst, evt);
+
+	return E_SUCCESS;
+}
+
+/******************************************************************************/
+
+unsigned hsm_sendFor( hsm_t *hsm, unsigned sig, unsigned param, cnt_t delay )
+{
+	hsm_event_t evt = { sig, param };
+
+	return box_sendFor(&hsm->queue, &evt, delay);
+}
+
+/******************************************************************************/
+
+unsigned hsm_waitFor( hsm_t *hsm, cnt_t delay )
+{
+	hsm_event_t evt;
+	unsigned    event = box_waitFor(&hsm->queue, &evt, delay);
+
+	if (event == E_SUCCESS)
+		event = hsm_dispatch(hsm, &evt);
+
+	return event;
+}
+
+/******************************************************************************/
+
+void hsm_run( hsm_t *hsm )
+{
+	for (;;)
+		hsm_waitFor(hsm, INFINITE);
+}
+
+/******************************************************************************/
+
+bool hsm_isIn( hsm_t *hsm, const hsm_state_t *s )
+{
+	const hsm_state_t *c;
+
+	for (c = hsm->state; c; c = c->parent)
+		if (c == s)
+			return true;
+
+	return false;
+}
+
+/******************************************************************************/
+
+#endif//USE_HSM
@@ -0,0 +1,158 @@
+/*******************************************************************************
+@file     hsm.h
+@author   agent
+@date     18.10.2026
+@brief    Table-driven hierarchical state machines.
+          States and their transitions are constant tables (placed in flash):
+          every state has a parent (NULL: top level), a default substate,
+          entry and exit actions and a transition table ended with HSM_END.
+          An event is looked up in the table of the current state, then of
+          its parents; the transition exits the states up to the common
+          ancestor, executes the action and enters the states down to the
+          target and its default substates. Dispatch is O(depth).
+          Events are queued in a mailbox of the kernel and dispatched one by
+          one by the task of the machine (run-to-completion): an event sent
+          from an action is dispatched after the current one.
+          Enabled with USE_HSM in DEFS.
+*******************************************************************************/
+
+#pragma once
+
+#include <os.h>
+
+/*******************************************************************************
+ Configuration
+*******************************************************************************/
+
+#ifndef   HSM_DEPTH
+#define   HSM_DEPTH            8  // <- maximum nesting depth of the entered states (init, targets)
+#endif
+
+/*******************************************************************************
+ Event signals; 0 is reserved for the end of the transition table
+*******************************************************************************/
+
+#define   hsmEnd      0U
+#define   hsmUser     1U // <- first signal of the application
+
+/*******************************************************************************
+ Event, copied through the queue of the machine
+*******************************************************************************/
+
+typedef struct __hsm_event
+{
+	unsigned           sig;
+	unsigned           param;
+
+}	hsm_event_t;
+
+typedef struct __hsm       hsm_t;
+typedef struct __hsm_state hsm_state_t;
+
+typedef void hsm_act_t( hsm_t *hsm, const hsm_event_t *evt );
+typedef bool hsm_grd_t( hsm_t *hsm, const hsm_event_t *evt );
+
+/*******************************************************************************
+ Transition; target NULL: internal transition (the action only, no exit / entry)
+ target equal to the source or its ancestor: the target is exited and entered
+*******************************************************************************/
+
+typedef struct __hsm_tran
+{
+	unsigned           sig;
+	hsm_grd_t         *guard;  // NULL: always taken
+	hsm_act_t         *action; // may be NULL
+	const hsm_state_t *target;
+
+}	hsm_tran_t;
+
+#define   HSM_END \
+	{ hsmEnd, NULL, NULL, NULL }
+
+/*******************************************************************************
+ State; a state with substates must have the default substate 'init'
+*******************************************************************************/
+
+struct __hsm_state
+{
+	const hsm_state_t *parent;
+	const hsm_state_t *init;
+	hsm_act_t         *entry;
+	hsm_act_t         *exit;
+	const hsm_tran_t  *tran;   // ended with HSM_END, may be NULL
+
+};
+
+#define  _HSM_STATE(parent, init, entry, exit, tran) \
+	{ (parent), (init), (entry), (exit), (tran) }
+
+/*******************************************************************************
+ State machine; may be embedded in the structure of the application
+*******************************************************************************/
+
+struct __hsm
+{
+	const hsm_state_t *state;  // current (leaf) state
+	box_t              queue;
+
+};
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*******************************************************************************
+ Initialize the machine with the event queue 'data' of 'bufsize' bytes
+ and enter the state 'init' (its parents first, then its default substates)
+ return: E_SUCCESS, E_FAILURE ('init' nested deeper than HSM_DEPTH, not entered)
+*******************************************************************************/
+
+unsigned  hsm_init( hsm_t *hsm, const hsm_state_t *init, hsm_event_t *data, unsigned bufsize );
+
+/*******************************************************************************
+ Dispatch the event at once, bypassing the queue; not from the actions
+ return: E_SUCCESS (transition taken), E_FAILURE (event ignored, or the target
+         nested deeper than HSM_DEPTH: the transition is not taken)
+*******************************************************************************/
+
+unsigned  hsm_dispatch( hsm_t *hsm, const hsm_event_t *evt );
+
+/*******************************************************************************
+ Send the event to the queue of the machine, wait up to 'delay' for free space;
+ may be called from interrupt handlers and actions with IMMEDIATE (hsm_give)
+ return: E_SUCCESS, E_TIMEOUT
+*******************************************************************************/
+
+unsigned  hsm_sendFor( hsm_t *hsm, unsigned sig, unsigned param, cnt_t delay );
+
+__STATIC_INLINE
+unsigned  hsm_send( hsm_t *hsm, unsigned sig, unsigned param ) { return hsm_sendFor(hsm, sig, param, INFINITE); }
+
+__STATIC_INLINE
+unsigned  hsm_give( hsm_t *hsm, unsigned sig, unsigned param ) { return hsm_sendFor(hsm, sig, param, IMMEDIATE); }
+
+/*******************************************************************************
+ Wait up to 'delay' for an event and dispatch it; for the task of the machine
+ return: E_SUCCESS, E_FAILURE (event ignored), E_TIMEOUT
+*******************************************************************************/
+
+unsigned  hsm_waitFor( hsm_t *hsm, cnt_t delay );
+
+/*******************************************************************************
+ Dispatch the events forever; the procedure of the task of the machine
+*******************************************************************************/
+
+__NO_RETURN
+void      hsm_run( hsm_t *hsm );
+
+/*******************************************************************************
+ Check if the machine is in the state 's' or in its substate
+*******************************************************************************/
+
+bool      hsm_isIn( hsm_t *hsm, const hsm_state_t *s );
+
+#ifdef __cplusplus
+}
+#endif
+
+/******************************************************************************/
@@ -0,0 +1,183 @@
+/*******************************************************************************
+@file     log.c
+@author   agent
+@date     18.10.2026
+@brief    Deferred-format binary logging.
+*******************************************************************************/
+
+#ifdef USE_LOG
+
+#include "log.h"
+#ifdef USE_SEMIHOST
+#include <stdio.h>
+#endif
+#ifdef USE_CPU_LOAD
+#include "cpuload.h"
+#endif
+#ifdef USE_USART
+#include "usart.h"
+#endif
+
+#if       LOG_SIZE & (LOG_SIZE - 1)
+#error    LOG_SIZE must be a power of 2!
+#endif
+
+#define   LOG_MASK (LOG_SIZE - 1)
+
+/*******************************************************************************
+ Ring buffer
+*******************************************************************************/
+
+static uint32_t          log_buf[LOG_SIZE];
+static volatile unsigned log_head;
+static volatile unsigned log_tail;
+static volatile unsigned log_lost;
+
+/* -------------------------------------------------------------------------- */
+
+__STATIC_INLINE
+uint32_t log_time( void )
+{
+#ifdef USE_CPU_LOAD
+	return cpu_cycles();
+#else
+	return (uint32_t) sys_time();
+#endif
+}
+
+/* -------------------------------------------------------------------------- */
+/* reserve space for a record of 'n' arguments and store its header and time stamp */
+
+__STATIC_INLINE
+bool log_begin( unsigned n, uint32_t id, unsigned *pos )
+{
+	unsigned head = log_head;
+
+	if (((log_tail - head - 1) & LOG_MASK) < n + 2)
+	{
+		log_lost++;
+		return false;
+	}
+
+	log_buf[head] = LOG_HDR(n, id); head = (head + 1) & LOG_MASK;
+	log_buf[head] = log_time();     head = (head + 1) & LOG_MASK;
+
+	*pos = head;
+	return true;
+}
+
+#define   LOG_ARG(x) do { log_buf[pos] = (x); pos = (pos + 1) & LOG_MASK; } while (0)
+
+/******************************************************************************/
+
+void log_put0( uint32_t id )
+{
+	unsigned pos;
+
+	sys_lock();
+	if (log_begin(0, id, &pos))
+		log_head = pos;
+	sys_unlock();
+}
+
+void log_put1( uint32_t id, uint32_t a )
+{
+	unsigned pos;
+
+	sys_lock();
+	if (log_begin(1, id, &pos))
+	{
+		LOG_ARG(a);
+		log_head = pos;
+	}
+	sys_unlock();
+}
+
+void log_put2( uint32_t id, uint32_t a, uint32_t b )
+{
+	unsigned pos;
+
+	sys_lock();
+	if (log_begin(2, id, &pos))
+	{
+		LOG_ARG(a); LOG_ARG(b);
+		log_head = pos;
+	}
+	sys_unlock();
+}
+
+void log_put3( uint32_t id, uint32_t a, uint32_t b, uint32_t c )
+{
+	unsigned pos;
+
+	sys_lock();
+	if (log_begin(3, id, &pos))
+	{
+		LOG_ARG(a); LOG_ARG(b); LOG_ARG(c);
+		log_head = pos;
+	}
+	sys_unlock();
+}
+
+void log_put4( uint32_t id, uint32_t a, uint32_t b, uint32_t c, uint32_t d )
+{
+	unsigned pos;
+
+	sys_lock();
+	if (log_begin(4, id, &pos))
+	{
+		LOG_ARG(a); LOG_ARG(b); LOG_ARG(c); LOG_ARG(d);
+		log_head = pos;
+	}
+	sys_unlock();
+}
+
+/******************************************************************************/
+
+void log_flush( void )
+{
+	unsigned head = log_head;
+	unsigned tail = log_tail;
+	unsigned lost;
+	uint32_t rec;
+
+	sys_lock();
+	lost = log_lost;
+	log_lost = 0;
+	sys_unlock();
+
+	if (lost)
+	{
+		rec = LOG_HDR(LOG_LOST, lost);
+		log_output(&rec, sizeof(rec));
+	}
+
+	while (tail != head)
+	{
+		/* the stored records are sent in place, in at most two parts */
+		unsigned len = (head > tail ? head : LOG_SIZE) - tail;
+		log_output(log_buf + tail, len * sizeof(uint32_t));
+		tail = (tail + len) & LOG_MASK;
+		log_tail = tail;
+	}
+}
+
+/******************************************************************************/
+
+__WEAK
+void log_output( const void *data, unsigned size )
+{
+#if   defined(USE_USART)
+	usart_write(data, size, INFINITE);
+#elif defined(USE_SEMIHOST)
+	fwrite(data, 1, size, stdout);
+	fflush(stdout);
+#else
+	(void) data;
+	(void) size;
+#endif
+}
+
+/******************************************************************************/
+
+#endif//USE_LOG
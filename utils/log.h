@@ -0,0 +1,92 @@
+/*******************************************************************************
+@file     log.h
+@author   agent
+@date     18.10.2026
+@brief    Deferred-format binary logging.
+          Enabled with USE_LOG in DEFS.
+          log_msg stores only the identifier of the format string, a time
+          stamp and up to four integer arguments in a RAM ring buffer;
+          the format strings are placed in the non-allocated '.logstr'
+          section (gnucc) and the stream is decoded on the host by
+          tools/logdecode.py using the ELF file.
+*******************************************************************************/
+
+#pragma once
+
+#include <os.h>
+
+/*******************************************************************************
+ Configuration
+*******************************************************************************/
+
+#ifndef   LOG_SIZE
+#define   LOG_SIZE         256    // <- size of the ring buffer in words, power of 2
+#endif
+
+/*******************************************************************************
+ Record format (32-bit little-endian words)
+ header:    0xA5 (8 bits) | number of arguments (4 bits) | format identifier (20 bits)
+ timestamp: cpu cycles (USE_CPU_LOAD) or system ticks
+ arguments: 0..4 words
+ a header with 15 arguments and no timestamp reports the number of lost records
+*******************************************************************************/
+
+#define   LOG_SYNC      0xA5U
+#define   LOG_LOST      0xFU
+#define   LOG_HDR(n, id)   ((LOG_SYNC << 24) | ((uint32_t)(n) << 20) | ((uint32_t)(id) & 0xFFFFFU))
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*******************************************************************************
+ Store a log record; may be called from interrupt handlers
+ fmt: string literal, printf-style with integer conversions only (%d %u %x %c ...)
+*******************************************************************************/
+
+#ifdef    USE_LOG
+
+#if defined(__GNUC__) && !defined(__ARMCC_VERSION)
+#define   LOG_SECTION   __attribute__((section(".logstr"), used))
+#else
+#define   LOG_SECTION   __attribute__((used))
+#endif
+
+#define   log_msg(fmt, ...) \
+	do { static const char LOG_SECTION _log_fmt[] = fmt; \
+	     LOG_CAT(log_put, LOG_NARG(__VA_ARGS__))((uint32_t)(uintptr_t)_log_fmt, ##__VA_ARGS__); } while (0)
+
+#else  // USE_LOG
+
+#define   log_msg(fmt, ...) do { } while (0)
+
+#endif // USE_LOG
+
+#define   LOG_CAT_(a, b) a ## b
+#define   LOG_CAT(a, b)  LOG_CAT_(a, b)
+#define   LOG_NARG(...)  LOG_NARG_(_, ##__VA_ARGS__, 4, 3, 2, 1, 0)
+#define   LOG_NARG_(_, a, b, c, d, n, ...) n
+
+void      log_put0( uint32_t id );
+void      log_put1( uint32_t id, uint32_t a );
+void      log_put2( uint32_t id, uint32_t a, uint32_t b );
+void      log_put3( uint32_t id, uint32_t a, uint32_t b, uint32_t c );
+void      log_put4( uint32_t id, uint32_t a, uint32_t b, uint32_t c, uint32_t d );
+
+/*******************************************************************************
+ Send all stored records through log_output; call from a low priority task
+*******************************************************************************/
+
+void      log_flush( void );
+
+/*******************************************************************************
+ Output of the binary stream, weak: USART (USE_USART), semihosting (USE_SEMIHOST)
+*******************************************************************************/
+
+void      log_output( const void *data, unsigned size );
+
+#ifdef __cplusplus
+}
+#endif
+
+/******************************************************************************/
@@ -0,0 +1,160 @@
+/*******************************************************************************
+@file     packet.c
+@author   agent
+@date     18.10.2026
+@brief    Zero-copy message passing: fixed-size buffers from a pool are sent
+          by reference, the ownership of the buffer moves with the pointer.
+*******************************************************************************/
+
+#ifdef USE_PACKET
+
+#include "packet.h"
+
+/*******************************************************************************
+ The semaphores are taken before and given after the lists are modified,
+ so a task that passed the semaphore always finds a buffer in the list
+*******************************************************************************/
+
+static
+void *pkt_get( pkt_pool_t *pool )
+{
+	pkt_hdr_t *hdr;
+
+	sys_lock();
+	{
+		hdr = pool->list;
+		if (hdr)
+		{
+			pool->list = hdr->next;
+		}
+		else
+		{
+			hdr = (pkt_hdr_t *) pool->next;
+			pool->next += pool->words;
+		}
+		hdr->pool = pool;
+	}
+	sys_unlock();
+
+	return hdr + 1;
+}
+
+/* -------------------------------------------------------------------------- */
+
+static
+void *pkt_pop( pkt_chan_t *chan )
+{
+	pkt_hdr_t *hdr;
+
+	sys_lock();
+	{
+		hdr = chan->head;
+		chan->head = hdr->next;
+		if (chan->head == NULL)
+			chan->tail = NULL;
+	}
+	sys_unlock();
+
+	return hdr + 1;
+}
+
+/******************************************************************************/
+
+void pkt_poolInit( pkt_pool_t *pool, uint32_t *data, unsigned count, unsigned size )
+{
+	sem_init(&pool->sem, count, count);
+	pool->list  = NULL;
+	pool->words = PKT_WORDS(size);
+	pool->next  = data;
+}
+
+/******************************************************************************/
+
+void pkt_chanInit( pkt_chan_t *chan )
+{
+	sem_init(&chan->sem, 0, semCounting);
+	chan->head = NULL;
+	chan->tail = NULL;
+}
+
+/******************************************************************************/
+
+void *pkt_alloc( pkt_pool_t *pool, cnt_t delay )
+{
+	if (sem_waitFor(&pool->sem, delay) != E_SUCCESS)
+		return NULL;
+
+	return pkt_get(pool);
+}
+
+/******************************************************************************/
+
+void *pkt_allocISR( pkt_pool_t *pool )
+{
+	if (sem_takeISR(&pool->sem) != E_SUCCESS)
+		return NULL;
+
+	return pkt_get(pool);
+}
+
+/******************************************************************************/
+
+void pkt_free( void *data )
+{
+	pkt_hdr_t  *hdr  = (pkt_hdr_t *) data - 1;
+	pkt_pool_t *pool = hdr->pool;
+
+	sys_lock();
+	{
+		hdr->next  = pool->list;
+		pool->list = hdr;
+	}
+	sys_unlock();
+
+	sem_giveISR(&pool->sem);
+}
+
+/******************************************************************************/
+
+void pkt_send( pkt_chan_t *chan, void *data )
+{
+	pkt_hdr_t *hdr = (pkt_hdr_t *) data - 1;
+
+	hdr->next = NULL;
+
+	sys_lock();
+	{
+		if (chan->tail)
+			chan->tail->next = hdr;
+		else
+			chan->head = hdr;
+		chan->tail = hdr;
+	}
+	sys_unlock();
+
+	sem_giveISR(&chan->sem);
+}
+
+/******************************************************************************/
+
+void *pkt_recv( pkt_chan_t *chan, cnt_t delay )
+{
+	if (sem_waitFor(&chan->sem, delay) != E_SUCCESS)
+		return NULL;
+
+	return pkt_pop(chan);
+}
+
+/******************************************************************************/
+
+void *pkt_recvISR( pkt_chan_t *chan )
+{
+	if (sem_takeISR(&chan->sem) != E_SUCCESS)
+		return NULL;
+
+	return pkt_pop(chan);
+}
+
+/******************************************************************************/
+
+#endif//USE_PACKET
@@ -0,0 +1,127 @@
+/*******************************************************************************
+@file     packet.h
+@author   agent
+@date     18.10.2026
+@brief    Zero-copy message passing: fixed-size buffers from a pool are sent
+          by reference, the ownership of the buffer moves with the pointer.
+          Enabled with USE_PACKET in DEFS.
+          The producer allocates a buffer, fills it and sends it to a channel;
+          the consumer receives the buffer and releases it back to its pool.
+*******************************************************************************/
+
+#pragma once
+
+#include <os.h>
+
+/*******************************************************************************
+ Buffer header, hidden in front of the data
+*******************************************************************************/
+
+typedef struct __pkt_hdr
+{
+	struct __pkt_hdr  *next;  // next buffer in the free list or in the channel
+	struct __pkt_pool *pool;  // owner of the buffer
+
+}	pkt_hdr_t;
+
+#define   PKT_WORDS(size)  ((sizeof(pkt_hdr_t) + (size) + 3) / 4) // words per buffer
+
+/*******************************************************************************
+ Pool of 'count' buffers of 'size' bytes
+ buffers not used yet are taken from the storage in turn, the released
+ ones are kept in the free list; the semaphore counts the available buffers
+*******************************************************************************/
+
+typedef struct __pkt_pool
+{
+	sem_t      sem;   // number of available buffers
+	pkt_hdr_t *list;  // released buffers
+	uint32_t  *next;  // first buffer never used
+	unsigned   words; // size of the buffer with the header in words
+
+}	pkt_pool_t;
+
+#define  _PKT_POOL_INIT(data, count, size) \
+	{ _SEM_INIT(count, count), NULL, (data), PKT_WORDS(size) }
+
+#define   OS_PKT_POOL(pool, count, size)                                    \
+	static uint32_t pool##__buf[(count) * PKT_WORDS(size)];                  \
+	pkt_pool_t pool[1] = { _PKT_POOL_INIT(pool##__buf, count, size) }
+
+#define   static_PKT_POOL(pool, count, size)                                \
+	static uint32_t pool##__buf[(count) * PKT_WORDS(size)];                  \
+	static pkt_pool_t pool[1] = { _PKT_POOL_INIT(pool##__buf, count, size) }
+
+/*******************************************************************************
+ Channel: FIFO of sent buffers
+ the semaphore counts the buffers in the channel
+*******************************************************************************/
+
+typedef struct __pkt_chan
+{
+	sem_t      sem;   // number of buffers in the channel
+	pkt_hdr_t *head;
+	pkt_hdr_t *tail;
+
+}	pkt_chan_t;
+
+#define  _PKT_CHAN_INIT() \
+	{ _SEM_INIT(0, semCounting), NULL, NULL }
+
+#define   OS_PKT_CHAN(chan) \
+	pkt_chan_t chan[1] = { _PKT_CHAN_INIT() }
+
+#define   static_PKT_CHAN(chan) \
+	static pkt_chan_t chan[1] = { _PKT_CHAN_INIT() }
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*******************************************************************************
+ Initialize the pool of 'count' buffers of 'size' bytes in the storage 'data'
+ of (count * PKT_WORDS(size)) words; and the channel
+*******************************************************************************/
+
+void      pkt_poolInit( pkt_pool_t *pool, uint32_t *data, unsigned count, unsigned size );
+void      pkt_chanInit( pkt_chan_t *chan );
+
+/*******************************************************************************
+ Allocate a buffer from the pool, wait up to 'delay' if the pool is empty
+ pkt_allocISR does not wait and may be called from interrupt handlers
+ return: pointer to the data of the buffer (word aligned), NULL on timeout
+*******************************************************************************/
+
+void     *pkt_alloc   ( pkt_pool_t *pool, cnt_t delay );
+void     *pkt_allocISR( pkt_pool_t *pool );
+
+/*******************************************************************************
+ Release the received (or allocated and not sent) buffer back to its pool
+ may be called from interrupt handlers
+*******************************************************************************/
+
+void      pkt_free( void *data );
+
+/*******************************************************************************
+ Send the buffer to the channel; the sender loses the ownership of the buffer
+ never waits (a buffer can be in one channel only); may be called from
+ interrupt handlers
+*******************************************************************************/
+
+void      pkt_send( pkt_chan_t *chan, void *data );
+
+/*******************************************************************************
+ Receive the oldest buffer from the channel, wait up to 'delay' if the channel
+ is empty; the receiver takes the ownership of the buffer
+ pkt_recvISR does not wait and may be called from interrupt handlers
+ return: pointer to the data of the buffer, NULL on timeout
+*******************************************************************************/
+
+void     *pkt_recv   ( pkt_chan_t *chan, cnt_t delay );
+void     *pkt_recvISR( pkt_chan_t *chan );
+
+#ifdef __cplusplus
+}
+#endif
+
+/******************************************************************************/
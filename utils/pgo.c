@@ -0,0 +1,28 @@
+/*******************************************************************************
+@file     pgo.c
+@author   agent
+@date     18.10.2026
+@brief    Training run of the profile-guided optimization (make pgo).
+*******************************************************************************/
+
+#ifdef USE_PGO
+
+#include "pgo.h"
+#include "semihost.h"
+
+void __gcov_dump( void );
+void initialise_monitor_handles( void );
+
+/******************************************************************************/
+
+void pgo_exit( void )
+{
+	/* the startup code of rdimon is not linked (-nostartfiles) */
+	initialise_monitor_handles();
+	__gcov_dump();
+	semihost_exit(0);
+}
+
+/******************************************************************************/
+
+#endif//USE_PGO
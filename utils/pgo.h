@@ -0,0 +1,37 @@
+/*******************************************************************************
+@file     pgo.h
+@author   agent
+@date     18.10.2026
+@brief    Training run of the profile-guided optimization (make pgo).
+          Enabled with USE_PGO in DEFS (set by the pgo-gen build profile);
+          the profile is written to the host through semihosting.
+          The training run is the application for PGO_TIME seconds,
+          or the benchmark (utils/bench.h) with USE_BENCH.
+*******************************************************************************/
+
+#pragma once
+
+/*******************************************************************************
+ Configuration
+*******************************************************************************/
+
+#ifndef   PGO_TIME
+#define   PGO_TIME          10    // <- length of the training run in seconds
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*******************************************************************************
+ End the training run: write the profile (.gcda files) to the host
+ and terminate the emulation
+*******************************************************************************/
+
+void      pgo_exit( void );
+
+#ifdef __cplusplus
+}
+#endif
+
+/******************************************************************************/
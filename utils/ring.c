@@ -0,0 +1,190 @@
+/*******************************************************************************
+@file     ring.c
+@author   agent
+@date     18.10.2026
+@brief    Wait-free single-producer / single-consumer ring buffer.
+*******************************************************************************/
+
+#ifdef USE_RING
+
+#include "ring.h"
+#include <string.h>
+
+/*******************************************************************************
+ Ordering of the accesses
+ producer: tail, barrier, data, barrier, head, barrier, wait
+ consumer: head, barrier, data, barrier, tail
+ a waiting consumer sets 'wait' and checks the ring again before it sleeps;
+ the producer clears 'wait' before it gives the semaphore, so a wakeup is
+ never lost (at most a spurious one, handled by the loop in ring_wait)
+*******************************************************************************/
+
+static
+void ring_copyIn( ring_t *ring, unsigned pos, const uint8_t *data, unsigned size )
+{
+	unsigned idx = pos & (ring->size - 1);
+	unsigned len = ring->size - idx;
+
+	/* the space was released by the consumer before */
+	__DMB();
+
+	if (len > size) len = size;
+	memcpy(ring->data + idx, data, len);
+	memcpy(ring->data, data + len, size - len);
+}
+
+/* -------------------------------------------------------------------------- */
+
+static
+void ring_copyOut( ring_t *ring, unsigned pos, uint8_t *data, unsigned size )
+{
+	unsigned idx = pos & (ring->size - 1);
+	unsigned len = ring->size - idx;
+
+	if (len > size) len = size;
+	memcpy(data, ring->data + idx, len);
+	memcpy(data + len, ring->data, size - len);
+}
+
+/* -------------------------------------------------------------------------- */
+
+static
+void ring_publish( ring_t *ring, unsigned head )
+{
+	__DMB();
+	ring->head = head;
+	__DMB();
+
+	if (ring->wait)
+	{
+		ring->wait = 0;
+		sem_giveISR(&ring->sem);
+	}
+}
+
+/* -------------------------------------------------------------------------- */
+
+static
+bool ring_wait( ring_t *ring, unsigned need, cnt_t delay )
+{
+	cnt_t time = 0;
+
+	if (ring_count(ring) >= need)
+		return true;
+
+	if (delay == IMMEDIATE)
+		return false;
+
+	if (delay != INFINITE)
+		time = sys_time() + delay;
+
+	for (;;)
+	{
+		ring->wait = 1;
+		__DMB();
+
+		if (ring_count(ring) >= need)
+			break;
+
+		if ((delay == INFINITE ? sem_wait(&ring->sem) : sem_waitUntil(&ring->sem, time)) != E_SUCCESS)
+			break;
+
+		if (ring_count(ring) >= need)
+			break;
+	}
+
+	ring->wait = 0;
+
+	return ring_count(ring) >= need;
+}
+
+/******************************************************************************/
+
+void ring_init( ring_t *ring, void *data, unsigned size )
+{
+	ring->head = 0;
+	ring->tail = 0;
+	ring->wait = 0;
+	sem_init(&ring->sem, 0, semBinary);
+	ring->size = size;
+	ring->data = data;
+}
+
+/******************************************************************************/
+
+unsigned ring_write( ring_t *ring, const void *data, unsigned size )
+{
+	unsigned head = ring->head;
+	unsigned room = ring->size - (head - ring->tail);
+
+	if (size > room)
+		size = room;
+
+	if (size > 0)
+	{
+		ring_copyIn(ring, head, data, size);
+		ring_publish(ring, head + size);
+	}
+
+	return size;
+}
+
+/******************************************************************************/
+
+bool ring_put( ring_t *ring, const void *data, unsigned size )
+{
+	unsigned head = ring->head;
+
+	if (size > ring->size - (head - ring->tail))
+		return false;
+
+	ring_copyIn(ring, head, data, size);
+	ring_publish(ring, head + size);
+
+	return true;
+}
+
+/******************************************************************************/
+
+unsigned ring_read( ring_t *ring, void *data, unsigned size, cnt_t delay )
+{
+	unsigned tail = ring->tail;
+	unsigned len;
+
+	if (size == 0 || !ring_wait(ring, 1, delay))
+		return 0;
+
+	len = ring->head - tail;
+	__DMB();
+
+	if (size > len)
+		size = len;
+
+	ring_copyOut(ring, tail, data, size);
+	__DMB();
+	ring->tail = tail + size;
+
+	return size;
+}
+
+/******************************************************************************/
+
+bool ring_get( ring_t *ring, void *data, unsigned size, cnt_t delay )
+{
+	unsigned tail = ring->tail;
+
+	if (size > ring->size || !ring_wait(ring, size, delay))
+		return false;
+
+	__DMB();
+
+	ring_copyOut(ring, tail, data, size);
+	__DMB();
+	ring->tail = tail + size;
+
+	return true;
+}
+
+/******************************************************************************/
+
+#endif//USE_RING
@@ -0,0 +1,93 @@
+/*******************************************************************************
+@file     ring.h
+@author   agent
+@date     18.10.2026
+@brief    Wait-free single-producer / single-consumer ring buffer.
+          Enabled with USE_RING in DEFS.
+          Push and pop use only aligned loads, stores and memory barriers;
+          no interrupts are masked on the data path (Cortex-M0 has no
+          exclusive access instructions). The consumer blocks on a semaphore
+          only when the ring does not hold the requested data; the producer
+          calls the kernel only when the consumer is waiting.
+          Typical use: interrupt handler (producer) to task (consumer) streams.
+*******************************************************************************/
+
+#pragma once
+
+#include <os.h>
+
+/*******************************************************************************
+ Ring buffer; 'size' must be a power of 2
+ 'head' is written by the producer only, 'tail' and 'wait' are set by the
+ consumer; the indexes are free-running, head - tail is the number of bytes
+*******************************************************************************/
+
+typedef struct __ring
+{
+	volatile unsigned head;
+	volatile unsigned tail;
+	volatile unsigned wait; // the consumer is waiting for data
+	sem_t             sem;
+	unsigned          size;
+	uint8_t          *data;
+
+}	ring_t;
+
+#define  _RING_INIT(size, data) \
+	{ 0, 0, 0, _SEM_INIT(0, semBinary), (size), (data) }
+
+#define  _RING_CHECK(ring, size) \
+	typedef char ring##__chk[((size) & ((size) - 1)) == 0 ? 1 : -1]
+
+#define   OS_RING(ring, size)                                   \
+	_RING_CHECK(ring, size);                                     \
+	static uint8_t ring##__buf[size];                            \
+	ring_t ring[1] = { _RING_INIT(size, ring##__buf) }
+
+#define   static_RING(ring, size)                               \
+	_RING_CHECK(ring, size);                                     \
+	static uint8_t ring##__buf[size];                            \
+	static ring_t ring[1] = { _RING_INIT(size, ring##__buf) }
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*******************************************************************************
+ Initialize the ring with the buffer of 'size' bytes (a power of 2)
+*******************************************************************************/
+
+void      ring_init( ring_t *ring, void *data, unsigned size );
+
+/*******************************************************************************
+ Producer side; never waits, may be called from interrupt handlers
+ ring_write: store as many bytes as fit; return the number of stored bytes
+ ring_put:   store the whole record or nothing; return true on success
+*******************************************************************************/
+
+unsigned  ring_write( ring_t *ring, const void *data, unsigned size );
+bool      ring_put  ( ring_t *ring, const void *data, unsigned size );
+
+/*******************************************************************************
+ Consumer side; waits up to 'delay' only if the ring is empty (ring_read)
+ or holds less than the whole record (ring_get); for tasks only,
+ unless called with IMMEDIATE
+ ring_read: take up to 'size' bytes; return the number of taken bytes
+ ring_get:  take the whole record or nothing; return true on success
+*******************************************************************************/
+
+unsigned  ring_read( ring_t *ring, void *data, unsigned size, cnt_t delay );
+bool      ring_get ( ring_t *ring, void *data, unsigned size, cnt_t delay );
+
+/*******************************************************************************
+ Number of bytes in the ring
+*******************************************************************************/
+
+__STATIC_INLINE
+unsigned  ring_count( ring_t *ring ) { return ring->head - ring->tail; }
+
+#ifdef __cplusplus
+}
+#endif
+
+/******************************************************************************/
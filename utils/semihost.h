@@ -0,0 +1,111 @@
+/*******************************************************************************
+@file     semihost.h
+@author   agent
+@date     19.10.2026
+@brief    Direct semihosting calls (qemu -semihosting or a debugger session),
+          independent of the library.
+          semihost_exit terminates the emulation: the _exit of the library
+          (rdimon) is never linked, the weak _exit of the startup code (an
+          endless loop, or the fault record with USE_FAULT) already defines
+          the symbol, so exit() does not stop qemu.
+          semihost_putc writes to the host console without the library
+          support (e.g. microlib).
+          Without a debugger or an emulator, bkpt raises the hard fault.
+          On the linux host simulator (startup/.host, HOST_SPEED defined by
+          its osport.h) the process exits and the console is stdout.
+*******************************************************************************/
+
+#pragma once
+
+#include <os.h>
+
+/*******************************************************************************
+ Semihosting operations and the reasons of SYS_EXIT (ARM semihosting spec)
+*******************************************************************************/
+
+#define   SEMIHOST_SYS_WRITEC        0x03
+#define   SEMIHOST_SYS_EXIT          0x18
+#define   SEMIHOST_APPLICATION_EXIT  0x20026 // ADP_Stopped_ApplicationExit
+#define   SEMIHOST_RUNTIME_ERROR     0x20023 // ADP_Stopped_RunTimeErrorUnknown
+
+#ifdef HOST_SPEED
+#include <stdio.h>
+#include <stdlib.h>
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef HOST_SPEED
+
+/*******************************************************************************
+ Semihosting operation 'op' with the parameter 'arg' (r0, r1)
+ return: the result of the operation (r0)
+*******************************************************************************/
+
+__STATIC_INLINE
+unsigned semihost_call( unsigned op, const void *arg )
+{
+#if defined(__ARMCC_VERSION) && (__ARMCC_VERSION < 6010050)
+	return (unsigned) __semihost(op, arg);
+#else
+	unsigned ret;
+
+	__ASM volatile
+	(
+		"mov   r0, %1  \n"
+		"mov   r1, %2  \n"
+		"bkpt  0xAB    \n"
+		"mov   %0, r0  \n"
+		: "=r" (ret) : "r" (op), "r" (arg) : "r0", "r1", "memory"
+	);
+
+	return ret;
+#endif
+}
+
+/*******************************************************************************
+ Terminate the program; 'status' other than 0 is reported as a run-time error
+*******************************************************************************/
+
+__STATIC_INLINE __NO_RETURN
+void semihost_exit( int status )
+{
+	uintptr_t reason = status == 0 ? SEMIHOST_APPLICATION_EXIT : SEMIHOST_RUNTIME_ERROR;
+
+	semihost_call(SEMIHOST_SYS_EXIT, (const void *) reason);
+	for (;;);
+}
+
+/*******************************************************************************
+ Write the character to the host console
+*******************************************************************************/
+
+__STATIC_INLINE
+void semihost_putc( char c )
+{
+	semihost_call(SEMIHOST_SYS_WRITEC, &c);
+}
+
+#else //HOST_SPEED
+
+__STATIC_INLINE __NO_RETURN
+void semihost_exit( int status )
+{
+	exit(status);
+}
+
+__STATIC_INLINE
+void semihost_putc( char c )
+{
+	putchar(c);
+}
+
+#endif//HOST_SPEED
+
+#ifdef __cplusplus
+}
+#endif
+
+/******************************************************************************/
@@ -0,0 +1,203 @@
+/*******************************************************************************
+@file     timeconv.h
+@author   agent
+@date     18.10.2026
+@brief    Division-free conversions between cpu cycles, system ticks, us and ms.
+          Cortex-M0 has no hardware divider: every division by a constant
+          that is not folded by the compiler calls __aeabi_uidiv (or the much
+          slower __aeabi_uldivmod for 64-bit values). These helpers replace
+          it with a multiplication by a reciprocal computed at compile time
+          from osconfig.h; the results are exact for every argument whose
+          result fits in the type (checked by tests/timeconv.c).
+*******************************************************************************/
+
+#pragma once
+
+#include <stdint.h>
+#include <osconfig.h>
+
+/*******************************************************************************
+ Compile-time reciprocal of the constant divisor 'd' (Granlund-Montgomery)
+ CNV_LOG2(d):  ceil(log2(d))
+ CNV_MAGIC(d): floor(2^32 * (2^CNV_LOG2(d) - d) / d) + 1
+*******************************************************************************/
+
+#define CNV_LOG2(d) ( \
+	(d) <= 0x00000001U ?  0 : (d) <= 0x00000002U ?  1 : (d) <= 0x00000004U ?  2 : (d) <= 0x00000008U ?  3 : \
+	(d) <= 0x00000010U ?  4 : (d) <= 0x00000020U ?  5 : (d) <= 0x00000040U ?  6 : (d) <= 0x00000080U ?  7 : \
+	(d) <= 0x00000100U ?  8 : (d) <= 0x00000200U ?  9 : (d) <= 0x00000400U ? 10 : (d) <= 0x00000800U ? 11 : \
+	(d) <= 0x00001000U ? 12 : (d) <= 0x00002000U ? 13 : (d) <= 0x00004000U ? 14 : (d) <= 0x00008000U ? 15 : \
+	(d) <= 0x00010000U ? 16 : (d) <= 0x00020000U ? 17 : (d) <= 0x00040000U ? 18 : (d) <= 0x00080000U ? 19 : \
+	(d) <= 0x00100000U ? 20 : (d) <= 0x00200000U ? 21 : (d) <= 0x00400000U ? 22 : (d) <= 0x00800000U ? 23 : \
+	(d) <= 0x01000000U ? 24 : (d) <= 0x02000000U ? 25 : (d) <= 0x04000000U ? 26 : (d) <= 0x08000000U ? 27 : \
+	(d) <= 0x10000000U ? 28 : (d) <= 0x20000000U ? 29 : (d) <= 0x40000000U ? 30 : (d) <= 0x80000000U ? 31 : 32 )
+
+#define CNV_MAGIC(d) \
+	((uint32_t)((((uint64_t)1 << 32) * (((uint64_t)1 << CNV_LOG2(d)) - (d))) / (d) + 1))
+
+/*******************************************************************************
+ Conversion factors
+*******************************************************************************/
+
+#define CNV_CYC_US  (CPU_FREQUENCY / 1000000)      // cpu cycles per microsecond
+#define CNV_CYC_TCK (CPU_FREQUENCY / OS_FREQUENCY) // cpu cycles per system tick
+
+#if CPU_FREQUENCY % 1000000 != 0 || CPU_FREQUENCY % OS_FREQUENCY != 0
+#error  osconfig.h: CPU_FREQUENCY must be a multiple of 1MHz and of OS_FREQUENCY!
+#endif
+#if 1000000 % OS_FREQUENCY != 0
+#error  osconfig.h: OS_FREQUENCY must be a divisor of 1000000!
+#endif
+
+#if OS_FREQUENCY >= 1000 ? OS_FREQUENCY % 1000 != 0 : 1000 % OS_FREQUENCY != 0
+#error  osconfig.h: OS_FREQUENCY must be a multiple or a divisor of 1000!
+#endif
+
+#define CNV_US_TCK  (1000000 / OS_FREQUENCY)       // microseconds per system tick
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*******************************************************************************
+ High word of the 32 x 32 bit product (Thumb-1 has no long multiplication)
+*******************************************************************************/
+
+static inline
+uint32_t cnv_mulhi( uint32_t a, uint32_t b )
+{
+	uint32_t a0 = a & 0xFFFF, a1 = a >> 16;
+	uint32_t b0 = b & 0xFFFF, b1 = b >> 16;
+	uint32_t lo = a0 * b0;
+	uint32_t m1 = a1 * b0;
+	uint32_t m2 = a0 * b1;
+	uint32_t md = (lo >> 16) + (m1 & 0xFFFF) + (m2 & 0xFFFF);
+
+	return a1 * b1 + (m1 >> 16) + (m2 >> 16) + (md >> 16);
+}
+
+/*******************************************************************************
+ Quotient of x / d, where d is a compile-time constant
+ cnv_div32: any 32-bit d
+ cnv_div64: 64-bit x, d < 2^16 (four 16-bit steps of long division),
+            a larger d does not compile
+*******************************************************************************/
+
+static inline
+uint32_t cnv_div32_( uint32_t x, uint32_t m, unsigned l )
+{
+	uint32_t t = cnv_mulhi(x, m);
+	return l == 0 ? x : (t + ((x - t) >> 1)) >> (l - 1);
+}
+
+#define cnv_div32(x, d) cnv_div32_((x), CNV_MAGIC(d), CNV_LOG2(d))
+
+static inline
+uint64_t cnv_div64_( uint64_t x, uint32_t d, uint32_t m, unsigned l )
+{
+	uint64_t q = 0;
+	uint32_t r = 0;
+	int      i;
+
+	for (i = 48; i >= 0; i -= 16)
+	{
+		uint32_t c = (r << 16) | (uint32_t)((x >> i) & 0xFFFF);
+		uint32_t n = cnv_div32_(c, m, l);
+		r = c - n * d;
+		q = (q << 16) | n;
+	}
+
+	return q;
+}
+
+#define cnv_div64(x, d) cnv_div64_((x), (d) + 0 * sizeof(char[(d) < 0x10000 ? 1 : -1]), CNV_MAGIC(d), CNV_LOG2(d))
+
+/*******************************************************************************
+ Conversions
+ to system ticks:   rounded up, so a delay is never shorter than requested
+ from system ticks: rounded down
+*******************************************************************************/
+
+static inline
+uint32_t cnv_cyc2us( uint32_t cyc )
+{
+	return cnv_div32(cyc, CNV_CYC_US);
+}
+
+static inline
+uint32_t cnv_cyc2tck( uint32_t cyc )
+{
+	return cnv_div32(cyc, CNV_CYC_TCK);
+}
+
+#if OS_TIMER_SIZE == 64
+
+static inline
+uint64_t cnv_us2tck( uint64_t us )
+{
+#if CNV_US_TCK < 0x10000
+	uint64_t tck = cnv_div64(us, CNV_US_TCK);
+#else
+	/* OS_FREQUENCY < 16: CNV_US_TCK is 1000 times a divisor of 1000,
+	   floor(floor(x / a) / b) == floor(x / (a * b)) */
+	uint64_t tck = cnv_div64(cnv_div64(us, 1000), CNV_US_TCK / 1000);
+#endif
+	return tck + (tck * CNV_US_TCK != us);
+}
+
+#else
+
+static inline
+uint32_t cnv_us2tck( uint32_t us )
+{
+	uint32_t tck = cnv_div32(us, CNV_US_TCK);
+	return tck + (tck * CNV_US_TCK != us);
+}
+
+#endif
+
+#if OS_FREQUENCY >= 1000
+
+#define  cnv_ms2tck(ms)  ((ms)  * (OS_FREQUENCY / 1000))
+#define  cnv_tck2us(tck) ((tck) * CNV_US_TCK)
+
+#if OS_TIMER_SIZE == 64
+#define  cnv_tck2ms(tck) cnv_div64((uint64_t)(tck), OS_FREQUENCY / 1000)
+#else
+#define  cnv_tck2ms(tck) cnv_div32((uint32_t)(tck), OS_FREQUENCY / 1000)
+#endif
+
+#else // OS_FREQUENCY < 1000
+
+#define  CNV_MS_TCK      (1000 / OS_FREQUENCY)   // milliseconds per system tick
+
+#if OS_TIMER_SIZE == 64
+
+static inline
+uint64_t cnv_ms2tck( uint64_t ms )
+{
+	uint64_t tck = cnv_div64(ms, CNV_MS_TCK);
+	return tck + (tck * CNV_MS_TCK != ms);
+}
+
+#else
+
+static inline
+uint32_t cnv_ms2tck( uint32_t ms )
+{
+	uint32_t tck = cnv_div32(ms, CNV_MS_TCK);
+	return tck + (tck * CNV_MS_TCK != ms);
+}
+
+#endif
+
+#define  cnv_tck2ms(tck) ((tck) * CNV_MS_TCK)
+#define  cnv_tck2us(tck) ((tck) * CNV_US_TCK)
+
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+/******************************************************************************/
@@ -0,0 +1,135 @@
+/*******************************************************************************
+@file     typed.hpp
+@author   agent
+@date     18.10.2026
+@brief    C++ templates of the kernel objects with compile-time sizes:
+          a task with its stack, a message queue of N elements of T,
+          a memory pool of N elements of T and a timer with a callable.
+          The objects are derived from the C structures and contain their
+          buffers, so nothing is allocated at runtime and the C functions
+          can be used with them too; every member function is an inline
+          call of the C function, the sizes and casts are resolved by the
+          compiler.
+          Header-only, C++14 (-std=gnu++14 -fno-rtti -fno-exceptions).
+*******************************************************************************/
+
+#pragma once
+
+#include <os.h>
+#include <type_traits>
+
+namespace typed {
+
+/*******************************************************************************
+ Task with a stack of 'Size' bytes
+ TaskT<256> led(1, led_proc); led.start();
+*******************************************************************************/
+
+template<size_t Size = OS_STACK_SIZE>
+struct TaskT : tsk_t
+{
+	TaskT( unsigned pri, fun_t *fun )              { tsk_init(this, pri, fun, stack_, sizeof(stack_)); }
+
+	void     start  ( void )                       {        tsk_start(this); }
+	void     suspend( void )                       {        tsk_suspend(this); }
+	void     resume ( void )                       {        tsk_resume(this); }
+
+	TaskT( const TaskT & ) = delete;
+	TaskT &operator=( const TaskT & ) = delete;
+
+	private:
+	stk_t stack_[STK_SIZE(Size)];
+};
+
+/*******************************************************************************
+ Message queue of 'Limit' elements of type T (copied in and out)
+ QueueT<sample_t, 8> q; q.send(s); q.wait(s);
+*******************************************************************************/
+
+template<class T, unsigned Limit>
+struct QueueT : box_t
+{
+	static_assert(std::is_trivially_copyable<T>::value, "QueueT: T must be trivially copyable");
+	static_assert(Limit > 0, "QueueT: Limit must not be zero");
+
+	QueueT( void )                                 { box_init(this, sizeof(T), data_, sizeof(data_)); }
+
+	unsigned waitFor( T &msg, cnt_t delay )        { return box_waitFor(this, &msg, delay); }
+	unsigned wait   ( T &msg )                     { return box_waitFor(this, &msg, INFINITE); }
+	unsigned take   ( T &msg )                     { return box_waitFor(this, &msg, IMMEDIATE); }
+	unsigned sendFor( const T &msg, cnt_t delay )  { return box_sendFor(this, &msg, delay); }
+	unsigned send   ( const T &msg )               { return box_sendFor(this, &msg, INFINITE); }
+	unsigned give   ( const T &msg )               { return box_sendFor(this, &msg, IMMEDIATE); }
+
+	QueueT( const QueueT & ) = delete;
+	QueueT &operator=( const QueueT & ) = delete;
+
+	private:
+	T data_[Limit];
+};
+
+/*******************************************************************************
+ Memory pool of 'Limit' elements of type T
+ the storage is returned as it is (not constructed), nullptr on timeout
+ PoolT<frame_t, 4> pool; frame_t *f = pool.wait(); ... pool.give(f);
+*******************************************************************************/
+
+template<class T, unsigned Limit>
+struct PoolT : mem_t
+{
+	static_assert(std::is_trivially_copyable<T>::value, "PoolT: T must be trivially copyable");
+	static_assert(Limit > 0, "PoolT: Limit must not be zero");
+
+	PoolT( void )                                  { mem_init(this, sizeof(T), data_, sizeof(data_)); }
+
+	T       *waitFor( cnt_t delay )                { void *p; return mem_waitFor(this, &p, delay) == E_SUCCESS ? static_cast<T *>(p) : nullptr; }
+	T       *wait   ( void )                       { return waitFor(INFINITE); }
+	T       *take   ( void )                       { return waitFor(IMMEDIATE); }
+	void     give   ( T *ptr )                     {        mem_give(this, ptr); }
+
+	PoolT( const PoolT & ) = delete;
+	PoolT &operator=( const PoolT & ) = delete;
+
+	private:
+	que_t data_[Limit * MEM_SIZE(sizeof(T))];
+};
+
+/*******************************************************************************
+ Timer calling the callable object 'fn' (a functor or a lambda)
+ after 'first' and then every 'every' (0: once)
+ the kernel procedure is a function without parameters, so the callable is
+ found through a static member of the class: at most one timer per type
+ of the callable (every lambda has its own type, all the functions of one
+ signature share the type of the pointer, so a function pointer is refused)
+ startFor return: E_SUCCESS, E_FAILURE (a second timer of the type F, not started)
+ auto blink = []{ led_toggle(); };
+ TimerT<decltype(blink)> t(blink); t.startFor(0, SEC/2);
+*******************************************************************************/
+
+template<class F>
+struct TimerT : tmr_t
+{
+	static_assert(!std::is_pointer<F>::value, "TimerT: F must be a functor or a lambda, not a function pointer");
+
+	explicit
+	TimerT( F fn ) : fn_(fn)                       { if (self_ == nullptr) self_ = this; tmr_init(this, proc); }
+	~TimerT( void )                                { if (self_ == this) { tmr_stop(this); self_ = nullptr; } }
+
+	unsigned startFor( cnt_t first, cnt_t every )  { if (self_ != this) return E_FAILURE; tmr_startFrom(this, first, every, proc); return E_SUCCESS; }
+	void     stop    ( void )                      {        tmr_stop(this); }
+
+	TimerT( const TimerT & ) = delete;
+	TimerT &operator=( const TimerT & ) = delete;
+
+	private:
+	F fn_;
+	static TimerT *self_;
+	static void proc( void )                       { self_->fn_(); }
+};
+
+template<class F>
+TimerT<F> *TimerT<F>::self_ = nullptr;
+
+}	// namespace typed
+
+/******************************************************************************/